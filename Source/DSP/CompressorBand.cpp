@@ -9,34 +9,104 @@
 */
 
 #include "CompressorBand.h"
+#include "Params.h"
 
 void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec) {
-    compressor.prepare(spec);
+    envelopeFilter.prepare(spec);
+    envelopeFilter.setLevelCalculationType(juce::dsp::BallisticsFilterLevelCalculationType::peak);
+    updateCompressorSettings(readSettings());
+}
+
+CompressorBand::Settings CompressorBand::readSettings() const
+{
+    Settings s;
+    s.attackMs = attack->get();
+    s.releaseMs = release->get();
+    s.thresholdDb = threshold->get();
+    s.ratio = Params::ratioChoices[(size_t)juce::jlimit(0, (int)Params::ratioChoices.size() - 1, ratio->getIndex())];
+    s.bypassed = bypassed->get();
+    s.mute = mute->get();
+    s.solo = solo->get();
+    return s;
 }
  
-void CompressorBand::updateCompressorSettings() {
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release ->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
+void CompressorBand::updateCompressorSettings(const Settings& newSettings) {
+    settings = newSettings;
+    
+    envelopeFilter.setAttackTime(settings.attackMs);
+    envelopeFilter.setReleaseTime(settings.releaseMs);
+    thresholdGain = juce::Decibels::decibelsToGain(settings.thresholdDb, -200.f);
+    thresholdInverse = 1.f / thresholdGain;
+    ratioInverse = 1.f / settings.ratio;
 }
 
 void CompressorBand::process(juce::AudioBuffer<float> &buffer)
 {
-    auto preRMS = computeRMSLevel(buffer);
-    auto block= juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+    
+    if( settings.bypassed || numChannels == 0 || numSamples == 0 )
+        return;
+    
+    //gain = (env / threshold) ^ (1/ratio - 1), done as exp(log(..) * slope) so the
+    //same log also gives the gain reduction in dB for the meters.
+    const auto slope = ratioInverse - 1.f;
+    const auto nepersToDb = 20.f / std::log(10.f);
     
-    context.isBypassed = bypassed->get();
-    compressor.process(context);
+    auto peakDb = blockPeakDb;
+    auto shallowestDb = blockShallowestDb;
+    auto sumDb = 0.0;
     
-    auto postRMS = computeRMSLevel(buffer);
+    for( int channel = 0; channel < numChannels; ++channel )
+    {
+        auto* samples = buffer.getWritePointer(channel);
+        auto channelSumDb = 0.f;
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            auto env = envelopeFilter.processSample(channel, samples[i]);
+            if( env < thresholdGain )
+            {
+                shallowestDb = 0.f;
+                continue;
+            }
+            
+            auto logGain = std::log(env * thresholdInverse) * slope;
+            samples[i] *= std::exp(logGain);
+            
+            auto grDb = logGain * nepersToDb;
+            peakDb = juce::jmin(peakDb, grDb);
+            shallowestDb = juce::jmax(shallowestDb, grDb);
+            channelSumDb += grDb;
+        }
+        
+        sumDb += channelSumDb;
+    }
+    
+    envelopeFilter.snapToZero();
     
-    auto convertToDb = [](auto input)
+    blockPeakDb = peakDb;
+    blockShallowestDb = shallowestDb;
+    blockSumDb += sumDb;
+    blockNumValues += numChannels * numSamples;
+}
+
+void CompressorBand::finishBlock()
+{
+    //a bypassed band processed nothing and reads as no gain reduction
+    if( blockNumValues == 0 )
+    {
+        gainReduction.publish({});
+        lastBlockRange = {};
+    }
+    else
     {
-        return juce::Decibels::gainToDecibels(input);
-    };
+        gainReduction.publish({ blockPeakDb, float(blockSumDb / blockNumValues) });
+        lastBlockRange = { blockPeakDb, blockShallowestDb };
+    }
     
-    rmsInputLevelDb.store(convertToDb(preRMS));
-    rmsOutputLevelDb.store(convertToDb(postRMS));
+    blockPeakDb = 0.f;
+    blockShallowestDb = std::numeric_limits<float>::lowest();
+    blockSumDb = 0.0;
+    blockNumValues = 0;
 }
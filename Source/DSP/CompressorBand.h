@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../GUI/Utilities.h"
+#include "GainReductionTelemetry.h"
 
 struct CompressorBand {
     
@@ -22,31 +23,62 @@ struct CompressorBand {
     juce::AudioParameterBool* mute {nullptr};
     juce::AudioParameterBool* solo {nullptr};
     
+    /**
+     everything the band reads from its parameters, taken once per block so the sub-blocks of
+     a block all see the same values
+     */
+    struct Settings
+    {
+        float attackMs {50.f};
+        float releaseMs {250.f};
+        float thresholdDb {0.f};
+        float ratio {1.f}; //the ratio itself, so a morph can land between the choices
+        bool bypassed {false};
+        bool mute {false};
+        bool solo {false};
+    };
+    
     void prepare(const juce::dsp::ProcessSpec& spec);
-     
-    void updateCompressorSettings();
     
+    Settings readSettings() const;
+    void updateCompressorSettings(const Settings& newSettings);
+    const Settings& getSettings() const { return settings; }
+    
+    /**
+     compresses one sub-block in place. a host block can take several of these, the meters
+     see them as one block once finishBlock() is called.
+     */
     void process(juce::AudioBuffer<float> &buffer);
     
-    float getRMSOutputLebelDb() const {return rmsOutputLevelDb;}
-    float getRMSInputLebelDb() const {return rmsInputLevelDb;}
+    /**
+     publishes the gain reduction of everything processed since the last call
+     */
+    void finishBlock();
+    
+    /**
+     the gain reduction the band actually applied during the last finished block
+     */
+    GainReductionTelemetry::Reading getGainReduction() const { return gainReduction.read(); }
+    
+    /**
+     the deepest and shallowest gain reduction in the last block. audio thread only.
+     */
+    juce::Range<float> getLastBlockGainReductionRange() const { return lastBlockRange; }
 private:
-     juce::dsp::Compressor<float> compressor;
+    /**
+     the same envelope follower and gain computer juce::dsp::Compressor uses, run inline
+     so the gain it applies can be measured without extra passes over the buffer.
+     */
+    juce::dsp::BallisticsFilter<float> envelopeFilter;
+    Settings settings;
+    float thresholdGain {1.f}, thresholdInverse {1.f}, ratioInverse {1.f};
     
-    std::atomic<float> rmsInputLevelDb {NEGATIVE_INFINITY};
-    std::atomic<float> rmsOutputLevelDb {NEGATIVE_INFINITY};
+    GainReductionTelemetry gainReduction;
+    juce::Range<float> lastBlockRange;
     
-    template<typename T>
-    float computeRMSLevel(const T& buffer)
-    {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for(int chan = 0; chan < numChannels; ++chan)
-        {
-            rms+= buffer.getRMSLevel(chan, 0, numSamples);
-        }
-        rms/= static_cast<float>(numChannels);
-        return rms;
-    }
+    //what the sub-blocks of the current block have applied so far
+    float blockPeakDb {0.f};
+    float blockShallowestDb {std::numeric_limits<float>::lowest()};
+    double blockSumDb {0.0};
+    int blockNumValues {0};
 };
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    CycleCounter.h
+    Created: 20 Oct 2026 10:02:15am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+/**
+ a cheap timestamp in CPU clock ticks, for measuring short stretches of code.
+ 
+ on x86 this is the time stamp counter, which runs at the CPU's nominal clock whatever the current
+ boost state, so a "cycle" here is a reference cycle. on 64 bit ARM it's the generic timer, which ticks
+ much slower than the core. anywhere else it falls back to the high resolution timer.
+ */
+struct CycleCounter
+{
+    static std::uint64_t now() noexcept
+    {
+       #if JUCE_INTEL
+        return __rdtsc();
+       #elif JUCE_ARM && JUCE_64BIT && ! JUCE_MSVC
+        std::uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+       #else
+        return (std::uint64_t)juce::Time::getHighResolutionTicks();
+       #endif
+    }
+    
+    /**
+     a name for what now() counts, to label results with
+     */
+    static const char* getUnit() noexcept
+    {
+       #if JUCE_INTEL
+        return "tsc";
+       #elif JUCE_ARM && JUCE_64BIT && ! JUCE_MSVC
+        return "cntvct";
+       #else
+        return "hires-ticks";
+       #endif
+    }
+};
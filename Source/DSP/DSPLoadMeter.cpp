@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    DSPLoadMeter.cpp
+    Created: 20 Oct 2026 6:05:37pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "DSPLoadMeter.h"
+
+void DSPLoadMeter::prepare(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate;
+    measurer.reset(sampleRate, maximumBlockSize);
+    peakLoad.store(0.f);
+}
+
+void DSPLoadMeter::registerBlock(juce::int64 ticks, int numSamples) noexcept
+{
+    if( numSamples <= 0 )
+        return;
+    
+    auto seconds = juce::Time::highResolutionTicksToSeconds(ticks);
+    measurer.registerRenderTime(seconds * 1000.0, numSamples);
+    
+    auto load = float(seconds * sampleRate / numSamples);
+    
+    //the reader only ever resets it to 0, so a lost race just drops one peak
+    if( load > peakLoad.load(std::memory_order_relaxed) )
+        peakLoad.store(load, std::memory_order_relaxed);
+}
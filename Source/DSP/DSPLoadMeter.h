@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    DSPLoadMeter.h
+    Created: 20 Oct 2026 6:05:37pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ how much of each block's real-time budget processBlock uses.
+ 
+ the audio thread times every block with a ScopedTimer. the load is the time taken over the
+ block's duration, so 1.0 is the whole budget and anything above that missed the deadline.
+ the average and the missed deadlines come from juce::AudioProcessLoadMeasurer, the peak is kept
+ here. the getters are safe from any thread.
+ */
+struct DSPLoadMeter
+{
+    void prepare(double sampleRate, int maximumBlockSize);
+    
+    struct ScopedTimer
+    {
+        ScopedTimer(DSPLoadMeter& m, int samples) noexcept :
+        meter(m),
+        numSamples(samples),
+        start(juce::Time::getHighResolutionTicks())
+        {
+        }
+        
+        ~ScopedTimer() noexcept
+        {
+            meter.registerBlock(juce::Time::getHighResolutionTicks() - start, numSamples);
+        }
+        
+        DSPLoadMeter& meter;
+        const int numSamples;
+        const juce::int64 start;
+    };
+    
+    /**
+     smoothed load, 0 to 1 and over when the budget's being missed
+     */
+    float getLoad() const { return (float)measurer.getLoadAsProportion(); }
+    
+    /**
+     the highest single block load since the last call, for a display to build its own peak hold from
+     */
+    float getAndResetPeakLoad() { return peakLoad.exchange(0.f); }
+    
+    /**
+     blocks that took longer than they last, since prepare()
+     */
+    int getNumMissedDeadlines() const { return measurer.getXRunCount(); }
+    
+private:
+    void registerBlock(juce::int64 ticks, int numSamples) noexcept;
+    
+    juce::AudioProcessLoadMeasurer measurer;
+    double sampleRate {44100.0};
+    
+    std::atomic<float> peakLoad {0.f};
+};
@@ -12,7 +12,7 @@
 #include <JuceHeader.h>
 
 #include <array>
-template<typename T>
+template<typename T, int Capacity = 30>
 struct Fifo
 {
     void prepare(int numChannels, int numSamples)
@@ -70,7 +70,6 @@ struct Fifo
         return fifo.getNumReady();
     }
 private:
-    static constexpr int Capacity = 30;
     std::array<T, Capacity> buffers;
     juce::AbstractFifo fifo {Capacity};
 };
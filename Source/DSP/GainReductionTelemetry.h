@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    GainReductionTelemetry.h
+    Created: 3 Dec 2022 4:48:15pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/**
+ one band's gain reduction over the last block, written by the audio thread and read by the UI.
+ 
+ the peak and the average are packed into a single atomic word so a reader never pairs the peak of
+ one block with the average of another, and neither side ever waits. each instance gets its own cache
+ line so the bands don't false-share while the audio thread writes them one after another.
+ */
+struct alignas(64) GainReductionTelemetry
+{
+    struct Reading
+    {
+        float peakDb {0.f};     //deepest gain reduction in the block, <= 0
+        float averageDb {0.f};  //mean gain reduction across every sample and channel, <= 0
+    };
+    
+    void publish(Reading reading) noexcept
+    {
+        std::uint64_t word;
+        std::memcpy(&word, &reading, sizeof(word));
+        packed.store(word, std::memory_order_relaxed);
+    }
+    
+    Reading read() const noexcept
+    {
+        auto word = packed.load(std::memory_order_relaxed);
+        Reading reading;
+        std::memcpy(static_cast<void*>(&reading), &word, sizeof(reading));
+        return reading;
+    }
+    
+private:
+    static_assert(sizeof(Reading) == sizeof(std::uint64_t));
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    
+    std::atomic<std::uint64_t> packed {0};
+};
+
+/**
+ a stretch of gain reduction history for the low, mid and high bands. the processor gathers its
+ blocks into one of these until it covers at least its historyBlockSize samples, then pushes it.
+ the history display turns them into pixel columns.
+ */
+struct GainReductionHistoryBlock
+{
+    std::array<float, 3> deepestDb {};
+    std::array<float, 3> shallowestDb {};
+    int numSamples {0};
+};
@@ -0,0 +1,304 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 19 Oct 2026 5:40:02pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+namespace
+{
+double energyToLufs(double energy)
+{
+    return energy > 0.0 ? -0.691 + 10.0 * std::log10(energy) : -100.0;
+}
+
+double lufsToEnergy(double lufs)
+{
+    return std::pow(10.0, (lufs + 0.691) / 10.0);
+}
+}
+
+void LoudnessMeter::prepare(double sampleRate, int numChannels)
+{
+    //BS.1770 gives the filters at 48 kHz, these are the analogue prototypes re-derived for any rate
+    {
+        const auto f0 = 1681.974450955533;
+        const auto gainDb = 3.999843853973347;
+        const auto q = 0.7071752369554196;
+        
+        const auto k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const auto vh = std::pow(10.0, gainDb / 20.0);
+        const auto vb = std::pow(vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+        
+        preFilter.b0 = (vh + vb * k / q + k * k) / a0;
+        preFilter.b1 = 2.0 * (k * k - vh) / a0;
+        preFilter.b2 = (vh - vb * k / q + k * k) / a0;
+        preFilter.a1 = 2.0 * (k * k - 1.0) / a0;
+        preFilter.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    {
+        const auto f0 = 38.13547087602444;
+        const auto q = 0.5003270373238773;
+        
+        const auto k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const auto a0 = 1.0 + k / q + k * k;
+        
+        rlbFilter.b0 = 1.0;
+        rlbFilter.b1 = -2.0;
+        rlbFilter.b2 = 1.0;
+        rlbFilter.a1 = 2.0 * (k * k - 1.0) / a0;
+        rlbFilter.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    
+    //only mono and stereo layouts are supported, both channels are weighted 1.0
+    numChannelsToMeasure = juce::jlimit(0, maxChannels, numChannels);
+    samplesPerSubBlock = juce::jmax(1, juce::roundToInt(sampleRate / 10.0));
+    
+    getBinEnergies();
+    clear();
+}
+
+void LoudnessMeter::clear()
+{
+    filterState = {};
+    samplesInSubBlock = 0;
+    subBlockEnergy = 0.0;
+    
+    subBlockEnergies.fill(0.0);
+    subBlockIndex = 0;
+    numSubBlocksSeen = 0;
+    momentarySum = 0.0;
+    shortTermSum = 0.0;
+    
+    momentaryHistogram.fill(0);
+    shortTermHistogram.fill(0);
+    
+    momentaryLufs.store(-100.f);
+    shortTermLufs.store(-100.f);
+    integratedLufs.store(-100.f);
+    loudnessRange.store(0.f);
+}
+
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer)
+{
+    if( resetRequested.exchange(false) )
+        clear();
+    
+    if( samplesPerSubBlock == 0 || numChannelsToMeasure == 0 )
+        return;
+    
+    jassert(buffer.getNumChannels() >= numChannelsToMeasure);
+    
+    auto* const* channels = buffer.getArrayOfReadPointers();
+    auto numSamples = buffer.getNumSamples();
+    auto start = 0;
+    
+    while( start < numSamples )
+    {
+        auto chunk = juce::jmin(numSamples - start, samplesPerSubBlock - samplesInSubBlock);
+        
+        if( numChannelsToMeasure == 2 )
+            processChunk<2>(channels, start, chunk);
+        else
+            processChunk<1>(channels, start, chunk);
+        
+        start += chunk;
+        samplesInSubBlock += chunk;
+        
+        if( samplesInSubBlock == samplesPerSubBlock )
+            finishSubBlock();
+    }
+}
+
+template<int NumChannels>
+void LoudnessMeter::processChunk(const float* const* channels, int startSample, int numSamples)
+{
+    //both biquads and the squaring happen in one pass. the inner loops run across channels,
+    //so with two channels each step is one two-lane double vector operation.
+    const auto pre = preFilter;
+    const auto rlb = rlbFilter;
+    auto s = filterState;
+    
+    double sum[NumChannels] {};
+    
+    for( int i = startSample; i < startSample + numSamples; ++i )
+    {
+        double x[NumChannels], y[NumChannels], z[NumChannels];
+        
+        for( int ch = 0; ch < NumChannels; ++ch )
+            x[ch] = channels[ch][i];
+        
+        for( int ch = 0; ch < NumChannels; ++ch )
+        {
+            y[ch] = pre.b0 * x[ch] + s.pre1[ch];
+            s.pre1[ch] = pre.b1 * x[ch] - pre.a1 * y[ch] + s.pre2[ch];
+            s.pre2[ch] = pre.b2 * x[ch] - pre.a2 * y[ch];
+        }
+        
+        for( int ch = 0; ch < NumChannels; ++ch )
+        {
+            z[ch] = rlb.b0 * y[ch] + s.rlb1[ch];
+            s.rlb1[ch] = rlb.b1 * y[ch] - rlb.a1 * z[ch] + s.rlb2[ch];
+            s.rlb2[ch] = rlb.b2 * y[ch] - rlb.a2 * z[ch];
+        }
+        
+        for( int ch = 0; ch < NumChannels; ++ch )
+            sum[ch] += z[ch] * z[ch];
+    }
+    
+    filterState = s;
+    
+    for( int ch = 0; ch < NumChannels; ++ch )
+        subBlockEnergy += sum[ch];
+}
+
+void LoudnessMeter::finishSubBlock()
+{
+    auto energy = subBlockEnergy / samplesPerSubBlock;
+    samplesInSubBlock = 0;
+    subBlockEnergy = 0.0;
+    
+    //running sums: add the newest sub-block, drop the one that just left each window
+    auto leaving = [this](int age)
+    {
+        return subBlockEnergies[(size_t)((subBlockIndex - age + shortTermSubBlocks) % shortTermSubBlocks)];
+    };
+    
+    momentarySum += energy - leaving(momentarySubBlocks);
+    shortTermSum += energy - leaving(shortTermSubBlocks);
+    subBlockEnergies[(size_t)subBlockIndex] = energy;
+    
+    subBlockIndex = (subBlockIndex + 1) % shortTermSubBlocks;
+    numSubBlocksSeen = juce::jmin(numSubBlocksSeen + 1, shortTermSubBlocks);
+    
+    //re-add from scratch once per lap so rounding can't accumulate over a long session
+    if( subBlockIndex == 0 )
+    {
+        shortTermSum = std::accumulate(subBlockEnergies.begin(), subBlockEnergies.end(), 0.0);
+        momentarySum = std::accumulate(subBlockEnergies.end() - momentarySubBlocks, subBlockEnergies.end(), 0.0);
+    }
+    
+    //until a window has filled it's averaged over what it has seen so far
+    auto momentary = energyToLufs(momentarySum / juce::jmin(numSubBlocksSeen, momentarySubBlocks));
+    auto shortTerm = energyToLufs(shortTermSum / numSubBlocksSeen);
+    
+    momentaryLufs.store(float(momentary));
+    shortTermLufs.store(float(shortTerm));
+    
+    //gating blocks overlap by 75%, so every sub-block completes one 400 ms block
+    if( numSubBlocksSeen >= momentarySubBlocks )
+    {
+        addToHistogram(momentaryHistogram, float(momentary));
+        integratedLufs.store(computeIntegrated(momentaryHistogram));
+    }
+    
+    if( numSubBlocksSeen >= shortTermSubBlocks )
+    {
+        addToHistogram(shortTermHistogram, float(shortTerm));
+        loudnessRange.store(computeRange(shortTermHistogram));
+    }
+}
+
+const std::array<double, LoudnessMeter::histogramBins>& LoudnessMeter::getBinEnergies()
+{
+    static const auto energies = []()
+    {
+        std::array<double, histogramBins> e;
+        for( int bin = 0; bin < histogramBins; ++bin )
+            e[(size_t)bin] = lufsToEnergy(minimumLufs + (bin + 0.5) / histogramBinsPerLu);
+        return e;
+    }();
+    
+    return energies;
+}
+
+void LoudnessMeter::addToHistogram(Histogram& histogram, float lufs)
+{
+    //the absolute gate
+    if( lufs < minimumLufs )
+        return;
+    
+    auto bin = juce::jmin(histogramBins - 1, int((lufs - minimumLufs) * histogramBinsPerLu));
+    ++histogram[(size_t)bin];
+}
+
+namespace
+{
+template<typename Histogram, typename Energies>
+double meanEnergy(const Histogram& histogram, const Energies& energies, int firstBin, std::uint64_t& count)
+{
+    auto sum = 0.0;
+    count = 0;
+    
+    for( size_t bin = (size_t)firstBin; bin < histogram.size(); ++bin )
+    {
+        sum += histogram[bin] * energies[bin];
+        count += histogram[bin];
+    }
+    
+    return count > 0 ? sum / double(count) : 0.0;
+}
+
+int firstBinAbove(double lufs, float minimumLufs, float binsPerLu, int numBins)
+{
+    return juce::jlimit(0, numBins, (int)std::ceil((lufs - minimumLufs) * binsPerLu - 0.5));
+}
+}
+
+float LoudnessMeter::computeIntegrated(const Histogram& histogram)
+{
+    const auto& energies = getBinEnergies();
+    std::uint64_t count;
+    
+    auto ungated = meanEnergy(histogram, energies, 0, count);
+    if( count == 0 )
+        return -100.f;
+    
+    //relative gate 10 LU below the absolute-gated loudness
+    auto gate = energyToLufs(ungated) - 10.0;
+    auto gated = meanEnergy(histogram, energies, firstBinAbove(gate, minimumLufs, histogramBinsPerLu, histogramBins), count);
+    
+    return count > 0 ? float(energyToLufs(gated)) : -100.f;
+}
+
+float LoudnessMeter::computeRange(const Histogram& histogram)
+{
+    const auto& energies = getBinEnergies();
+    std::uint64_t count;
+    
+    auto ungated = meanEnergy(histogram, energies, 0, count);
+    if( count == 0 )
+        return 0.f;
+    
+    //EBU Tech 3342: relative gate 20 LU down, then the spread between the 10th and 95th percentiles
+    auto firstBin = firstBinAbove(energyToLufs(ungated) - 20.0, minimumLufs, histogramBinsPerLu, histogramBins);
+    meanEnergy(histogram, energies, firstBin, count);
+    if( count == 0 )
+        return 0.f;
+    
+    auto percentileBin = [&histogram, firstBin, count](double percentile)
+    {
+        auto target = std::uint64_t(std::ceil(percentile * count));
+        std::uint64_t seen = 0;
+        
+        for( int bin = firstBin; bin < histogramBins; ++bin )
+        {
+            seen += histogram[(size_t)bin];
+            if( seen >= juce::jmax<std::uint64_t>(target, 1) )
+                return bin;
+        }
+        
+        return histogramBins - 1;
+    };
+    
+    auto low = percentileBin(0.10);
+    auto high = percentileBin(0.95);
+    
+    return (high - low) / histogramBinsPerLu;
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 19 Oct 2026 5:40:02pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ EBU R128 / ITU-R BS.1770 loudness: momentary (400 ms), short-term (3 s), integrated and loudness range.
+ 
+ process() runs on the audio thread and publishes all four values every 100 ms.
+ the getters and reset() are safe to call from any thread.
+ 
+ the signal is K-weighted and squared in 100 ms sub-blocks. the 400 ms and 3 s windows are
+ running sums over the last 4 and 30 sub-blocks. the gated measurements keep a 0.1 LU histogram
+ of block loudness instead of every block, so memory stays the same however long the program runs.
+ */
+struct LoudnessMeter
+{
+    static constexpr float minimumLufs = -70.f;
+    
+    void prepare(double sampleRate, int numChannels);
+    void process(const juce::AudioBuffer<float>& buffer);
+    
+    /**
+     restarts the integrated and range measurements. picked up by the next process() call.
+     */
+    void reset() { resetRequested.store(true); }
+    
+    float getMomentaryLufs() const { return momentaryLufs.load(); }
+    float getShortTermLufs() const { return shortTermLufs.load(); }
+    float getIntegratedLufs() const { return integratedLufs.load(); }
+    float getLoudnessRange() const { return loudnessRange.load(); }
+    
+private:
+    static constexpr int maxChannels = 2;
+    static constexpr int momentarySubBlocks = 4;
+    static constexpr int shortTermSubBlocks = 30;
+    
+    struct Biquad
+    {
+        double b0 {1.0}, b1 {0.0}, b2 {0.0}, a1 {0.0}, a2 {0.0};
+    };
+    
+    //the high shelf head model, then the RLB highpass
+    Biquad preFilter, rlbFilter;
+    
+    //transposed direct form II state, laid out so the channels sit next to each other
+    //and both channels of a stage update as one vector operation
+    struct alignas(16) FilterState
+    {
+        double pre1[maxChannels] {}, pre2[maxChannels] {};
+        double rlb1[maxChannels] {}, rlb2[maxChannels] {};
+    };
+    FilterState filterState;
+    
+    int numChannelsToMeasure {0};
+    int samplesPerSubBlock {0};
+    int samplesInSubBlock {0};
+    double subBlockEnergy {0.0};
+    
+    std::array<double, shortTermSubBlocks> subBlockEnergies {};
+    int subBlockIndex {0};
+    int numSubBlocksSeen {0};
+    double momentarySum {0.0};
+    double shortTermSum {0.0};
+    
+    /**
+     block counts in 0.1 LU bins from 'minimumLufs' up
+     */
+    static constexpr int histogramBins = 1000;
+    static constexpr float histogramBinsPerLu = 10.f;
+    using Histogram = std::array<std::uint32_t, histogramBins>;
+    Histogram momentaryHistogram {}, shortTermHistogram {};
+    
+    static const std::array<double, histogramBins>& getBinEnergies();
+    static void addToHistogram(Histogram& histogram, float lufs);
+    static float computeIntegrated(const Histogram& histogram);
+    static float computeRange(const Histogram& histogram);
+    
+    template<int NumChannels>
+    void processChunk(const float* const* channels, int startSample, int numSamples);
+    void finishSubBlock();
+    void clear();
+    
+    std::atomic<bool> resetRequested {false};
+    std::atomic<float> momentaryLufs {-100.f};
+    std::atomic<float> shortTermLufs {-100.f};
+    std::atomic<float> integratedLufs {-100.f};
+    std::atomic<float> loudnessRange {0.f};
+};
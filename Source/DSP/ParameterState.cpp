@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ParameterState.cpp
+    Created: 21 Oct 2026 1:26:40pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "ParameterState.h"
+
+namespace
+{
+//a ValueTree stream starts with the tree's type name, "Parameters" for ours
+constexpr juce::uint32 magic = 0x5343424d; // "MBCS"
+constexpr juce::uint16 version = 1;
+constexpr int headerSize = 8;
+}
+
+void ParameterState::writeValues(const Parameters& parameters, void* dest)
+{
+    auto* bytes = static_cast<char*>(dest);
+    
+    for( auto* param : parameters )
+    {
+        jassert(param != nullptr);
+        
+        auto value = param->convertFrom0to1(param->getValue());
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        
+        bits = juce::ByteOrder::swapIfBigEndian(bits);
+        std::memcpy(bytes, &bits, sizeof(bits));
+        bytes += sizeof(bits);
+    }
+}
+
+void ParameterState::applyValues(const Parameters& parameters, const void* values, int count)
+{
+    auto* bytes = static_cast<const juce::uint8*>(values);
+    
+    for( size_t i = 0; i < parameters.size(); ++i )
+    {
+        auto* param = parameters[i];
+        jassert(param != nullptr);
+        
+        auto normalised = param->getDefaultValue();
+        
+        if( (int)i < count )
+        {
+            auto bits = juce::ByteOrder::littleEndianInt(bytes + i * sizeof(float));
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            
+            if( std::isfinite(value) )
+                normalised = param->convertTo0to1(value);
+        }
+        
+        //the host and the attachments only hear about what actually changed
+        if( param->getValue() != normalised )
+            param->setValueNotifyingHost(normalised);
+    }
+}
+
+void ParameterState::write(const Parameters& parameters, juce::MemoryBlock& destData)
+{
+    destData.setSize(headerSize + parameters.size() * sizeof(float));
+    auto* bytes = static_cast<char*>(destData.getData());
+    
+    auto put = [&bytes](auto value)
+    {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(bytes, &value, sizeof(value));
+        bytes += sizeof(value);
+    };
+    
+    put(magic);
+    put(version);
+    put(juce::uint16(parameters.size()));
+    
+    writeValues(parameters, bytes);
+}
+
+namespace
+{
+/**
+ the version in the header, or 0 if the data isn't in this format
+ */
+juce::uint16 readVersion(const void* data, int sizeInBytes)
+{
+    if( data == nullptr || sizeInBytes < headerSize )
+        return 0;
+    
+    auto* bytes = static_cast<const juce::uint8*>(data);
+    
+    if( juce::ByteOrder::littleEndianInt(bytes) != magic )
+        return 0;
+    
+    return juce::ByteOrder::littleEndianShort(bytes + 4);
+}
+}
+
+bool ParameterState::isThisFormat(const void* data, int sizeInBytes)
+{
+    return data != nullptr
+        && sizeInBytes >= (int)sizeof(magic)
+        && juce::ByteOrder::littleEndianInt(data) == magic;
+}
+
+int ParameterState::read(const Parameters& parameters, const void* data, int sizeInBytes)
+{
+    //every version so far has this layout. a later one that changes it would be migrated here.
+    auto dataVersion = readVersion(data, sizeInBytes);
+    if( dataVersion == 0 || dataVersion > version )
+        return 0;
+    
+    auto* bytes = static_cast<const juce::uint8*>(data);
+    
+    auto count = (int)juce::ByteOrder::littleEndianShort(bytes + 6);
+    if( sizeInBytes < headerSize + count * (int)sizeof(float) )
+        return 0;
+    
+    applyValues(parameters, bytes + headerSize, count);
+    return headerSize + count * (int)sizeof(float);
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ParameterState.h
+    Created: 21 Oct 2026 1:26:40pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+
+/**
+ the plugin's saved state as a compact binary blob, written and read without building a ValueTree.
+ 
+ the layout is a 4 byte magic, a 16 bit version and a 16 bit parameter count, then one 32 bit
+ float per parameter in Params::Names order, in the parameter's own units. everything is little
+ endian. new parameters are only ever appended to Names, so an older blob just has fewer values
+ and the ones it doesn't have go back to their defaults. a blob with more values than this build
+ has parameters loads the ones it knows. the version only goes up when the layout changes in a way
+ appending can't cover, and a blob from a newer version than this one isn't loaded at all.
+ */
+namespace ParameterState
+{
+using Parameters = std::array<juce::RangedAudioParameter*, Params::NumParams>;
+
+void write(const Parameters& parameters, juce::MemoryBlock& destData);
+
+/**
+ applies a blob written by write() and returns how many bytes it used. returns 0, and changes
+ nothing, if the data isn't in this format, so the caller can try the older ValueTree format.
+ it also returns 0 for data that is in this format but is truncated or from a newer version,
+ which isThisFormat() tells apart.
+ */
+int read(const Parameters& parameters, const void* data, int sizeInBytes);
+
+/**
+ true if the data starts with this format's magic, whether or not read() can load it
+ */
+bool isThisFormat(const void* data, int sizeInBytes);
+
+/**
+ the values on their own, without the header: parameters.size() little endian floats at 'dest'
+ */
+void writeValues(const Parameters& parameters, void* dest);
+
+/**
+ sets the parameters from 'count' values laid out as writeValues() writes them. parameters past
+ 'count' go back to their defaults.
+ */
+void applyValues(const Parameters& parameters, const void* values, int count);
+}
@@ -9,3 +9,51 @@
 */
 
 #include "Params.h"
+
+juce::AudioProcessorValueTreeState::ParameterLayout Params::createParameterLayout()
+{
+    using namespace juce;
+    
+    AudioProcessorValueTreeState::ParameterLayout layout;
+    
+    for( const auto& spec : parameterTable )
+    {
+        auto id = ParameterID { spec.id, 1 };
+        
+        switch( spec.kind )
+        {
+            case Kind::Float:
+                layout.add(std::make_unique<AudioParameterFloat>(id,
+                                                                 spec.id,
+                                                                 NormalisableRange<float>(spec.minimum, spec.maximum, spec.interval, 1),
+                                                                 spec.defaultValue));
+                break;
+                
+            case Kind::Choice:
+                layout.add(std::make_unique<AudioParameterChoice>(id,
+                                                                  spec.id,
+                                                                  StringArray(spec.choices, spec.numChoices),
+                                                                  (int)spec.defaultValue));
+                break;
+                
+            case Kind::Bool:
+                layout.add(std::make_unique<AudioParameterBool>(id,
+                                                                spec.id,
+                                                                spec.defaultValue != 0.f));
+                break;
+        }
+    }
+    
+    return layout;
+}
+
+juce::RangedAudioParameter& Params::getParam(const juce::AudioProcessor& processor, Names name)
+{
+    auto* param = processor.getParameters()[getLayoutIndex(name)];
+    
+    //if this fires the processor's parameters weren't made by createParameterLayout()
+    jassert(dynamic_cast<juce::RangedAudioParameter*>(param) != nullptr
+            && static_cast<juce::RangedAudioParameter*>(param)->getParameterID() == getId(name));
+    
+    return *static_cast<juce::RangedAudioParameter*>(param);
+}
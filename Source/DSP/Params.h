@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../GUI/Utilities.h"
 
 
 namespace Params {
@@ -47,47 +48,244 @@ enum Names {
     
     Gain_in,
     Gain_out,
+    
+    True_Peak_Limiter,
+    True_Peak_Ceiling,
+    
+    Morph,
+    
+    //the saved state stores values in this order, so new parameters go above this line
+    NumParams
+};
+
+/**
+ the Ratio parameters' choices, by choice index. the audio thread reads the ratio from here
+ rather than parsing the choice name, which builds a String.
+ */
+inline constexpr std::array<float, 14> ratioChoices { 1.f, 1.5f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 10.f, 15.f, 20.f, 50.f, 100.f };
+
+/**
+ the ratio choices as the parameters show them
+ */
+inline constexpr std::array<const char*, 14> ratioChoiceNames { "1.0", "1.5", "2.0", "3.0", "4.0", "5.0", "6.0", "7.0", "8.0", "10.0", "15.0", "20.0", "50.0", "100.0" };
+static_assert(ratioChoiceNames.size() == ratioChoices.size());
+
+//==============================================================================
+enum class Kind
+{
+    Float,
+    Choice,
+    Bool
+};
+
+/**
+ everything about one parameter. the ID is also the name the host shows. the range and the
+ default are in the parameter's own units, for a choice the range is the choice indices and
+ for a switch it's 0 to 1.
+ */
+struct Spec
+{
+    Names name;
+    const char* id;
+    Kind kind;
+    float minimum;
+    float maximum;
+    float interval;
+    float defaultValue;
+    const char* const* choices;
+    int numChoices;
 };
-inline const std::map<Names, juce::String>& GetParams()
+
+constexpr Spec makeFloat(Names name, const char* id, float minimum, float maximum, float interval, float defaultValue)
+{
+    return { name, id, Kind::Float, minimum, maximum, interval, defaultValue, nullptr, 0 };
+}
+
+template<size_t numChoices>
+constexpr Spec makeChoice(Names name, const char* id, const std::array<const char*, numChoices>& choices, int defaultIndex)
+{
+    return { name, id, Kind::Choice, 0.f, float(numChoices - 1), 1.f, float(defaultIndex), choices.data(), (int)numChoices };
+}
+
+constexpr Spec makeBool(Names name, const char* id, bool defaultValue)
 {
-    static std::map<Names, juce::String> params =
+    return { name, id, Kind::Bool, 0.f, 1.f, 1.f, defaultValue ? 1.f : 0.f, nullptr, 0 };
+}
+
+/**
+ every parameter, in the order the layout adds them. hosts that address parameters by index
+ see this order, so new parameters are appended rather than slotted in.
+ */
+inline constexpr std::array<Spec, NumParams> parameterTable
+{{
+    makeFloat(Gain_in, "Gain_in", -24.f, 24.f, 0.5f, 0.f),
+    makeFloat(Gain_out, "Gain_out", -24.f, 24.f, 0.5f, 0.f),
+    
+    makeFloat(Threshold_Low_Band, "Threshold Low Band", MIN_THRESHOLD, MAX_DECIBELS, 1.f, 0.f),
+    makeFloat(Threshold_Mid_Band, "Threshold Mid Band", MIN_THRESHOLD, MAX_DECIBELS, 1.f, 0.f),
+    makeFloat(Threshold_High_Band, "Threshold High Band", MIN_THRESHOLD, MAX_DECIBELS, 1.f, 0.f),
+    
+    makeFloat(Attack_Low_Band, "Attack Low Band", 5.f, 500.f, 1.f, 50.f),
+    makeFloat(Attack_Mid_Band, "Attack Mid Band", 5.f, 500.f, 1.f, 50.f),
+    makeFloat(Attack_High_Band, "Attack High Band", 5.f, 500.f, 1.f, 50.f),
+    
+    makeFloat(Release_Low_Band, "Release Low Band", 5.f, 500.f, 1.f, 250.f),
+    makeFloat(Release_Mid_Band, "Release Mid Band", 5.f, 500.f, 1.f, 250.f),
+    makeFloat(Release_High_Band, "Release High Band", 5.f, 500.f, 1.f, 250.f),
+    
+    makeChoice(Ratio_Low_Band, "Ratio Low Band", ratioChoiceNames, 3),
+    makeChoice(Ratio_Mid_Band, "Ratio Mid Band", ratioChoiceNames, 3),
+    makeChoice(Ratio_High_Band, "Ratio High Band", ratioChoiceNames, 3),
+    
+    makeBool(Bypassed_Low_Band, "Bypassed Low Band", false),
+    makeBool(Bypassed_Mid_Band, "Bypassed Mid Band", false),
+    makeBool(Bypassed_High_Band, "Bypassed High Band", false),
+    
+    makeBool(Mute_Low_Band, "Mute Low Band", false),
+    makeBool(Mute_Mid_Band, "Mute Mid Band", false),
+    makeBool(Mute_High_Band, "Mute High Band", false),
+    
+    makeBool(Solo_Low_Band, "Solo Low Band", false),
+    makeBool(Solo_Mid_Band, "Solo Mid Band", false),
+    makeBool(Solo_High_Band, "Solo High Band", false),
+    
+    makeFloat(Low_Mid_Crossover_Freq, "Low_Mid Crossover Freq", MIN_FREQUENCY, 999.f, 1.f, 400.f),
+    makeFloat(Mid_High_Crossover_Freq, "Mid_High Crossover Freq", 1000.f, MAX_FREQUENCY, 1.f, 2000.f),
+    
+    makeBool(True_Peak_Limiter, "True Peak Limiter", false),
+    makeFloat(True_Peak_Ceiling, "True Peak Ceiling", -12.f, 0.f, 0.1f, -1.f),
+    
+    //0 is snapshot A, 100 is snapshot B. does nothing until both are stored
+    makeFloat(Morph, "Morph", 0.f, 100.f, 0.1f, 0.f),
+}};
+
+/**
+ each name's position in parameterTable, worked out at compile time. -1 for a name that's missing.
+ */
+inline constexpr std::array<int, NumParams> tableIndices = []
+{
+    std::array<int, NumParams> indices {};
+    for( auto& index : indices )
+        index = -1;
+    
+    for( size_t i = 0; i < parameterTable.size(); ++i )
+        indices[(size_t)parameterTable[i].name] = (int)i;
+    
+    return indices;
+}();
+
+constexpr bool everyNameIsInTheTable()
+{
+    for( auto index : tableIndices )
+    {
+        if( index < 0 )
+            return false;
+    }
+    
+    return true;
+}
+
+static_assert(everyNameIsInTheTable(), "every parameter needs exactly one row in parameterTable");
+
+/**
+ where 'name' is in the layout, and so in AudioProcessor::getParameters()
+ */
+constexpr int getLayoutIndex(Names name) { return tableIndices[(size_t)name]; }
+
+constexpr const Spec& getSpec(Names name) { return parameterTable[(size_t)getLayoutIndex(name)]; }
+
+constexpr const char* getId(Names name) { return getSpec(name).id; }
+
+//==============================================================================
+constexpr int numBands = 3;
+
+/**
+ the same parameter for another band. 'lowBandName' is one of the *_Low_Band names and 'band'
+ is 0 for low, 1 for mid and 2 for high.
+ */
+constexpr Names forBand(Names lowBandName, int band) { return Names(lowBandName + band); }
+
+constexpr bool bandsAreConsecutive()
+{
+    for( auto low : { Threshold_Low_Band, Attack_Low_Band, Release_Low_Band, Ratio_Low_Band,
+                      Bypassed_Low_Band, Mute_Low_Band, Solo_Low_Band } )
+    {
+        for( int band = 1; band < numBands; ++band )
+        {
+            const auto& first = getSpec(low);
+            const auto& other = getSpec(forBand(low, band));
+            
+            if( other.kind != first.kind || other.minimum != first.minimum || other.maximum != first.maximum )
+                return false;
+        }
+    }
+    
+    return true;
+}
+
+static_assert(bandsAreConsecutive(), "forBand() needs each band's parameters next to each other in Names");
+
+//==============================================================================
+template<Kind kind> struct ParamClass;
+template<> struct ParamClass<Kind::Float> { using Type = juce::AudioParameterFloat; };
+template<> struct ParamClass<Kind::Choice> { using Type = juce::AudioParameterChoice; };
+template<> struct ParamClass<Kind::Bool> { using Type = juce::AudioParameterBool; };
+
+/**
+ the class the layout makes for 'name'
+ */
+template<Names name>
+using ParamType = typename ParamClass<getSpec(name).kind>::Type;
+
+template<typename T>
+constexpr Kind getKind()
+{
+    if constexpr( std::is_same_v<T, juce::AudioParameterFloat> )
+        return Kind::Float;
+    else if constexpr( std::is_same_v<T, juce::AudioParameterChoice> )
+        return Kind::Choice;
+    else
     {
-        
-        {Low_Mid_Crossover_Freq, "Low_Mid Crossover Freq"},
-        {Mid_High_Crossover_Freq, "Mid_High Crossover Freq"},
-        
-        {Threshold_Low_Band, "Threshold Low Band"},
-        {Threshold_Mid_Band, "Threshold Mid Band"},
-        {Threshold_High_Band, "Threshold High Band"},
-        
-        {Attack_Low_Band, "Attack Low Band"},
-        {Attack_Mid_Band, "Attack Mid Band"},
-        {Attack_High_Band, "Attack High Band"},
-        
-        {Release_Low_Band, "Release Low Band"},
-        {Release_Mid_Band, "Release Mid Band"},
-        {Release_High_Band, "Release High Band"},
-        
-        {Ratio_Low_Band, "Ratio Low Band"},
-        {Ratio_Mid_Band, "Ratio Mid Band"},
-        {Ratio_High_Band, "Ratio High Band"},
-        
-        {Bypassed_Low_Band, "Bypassed Low Band"},
-        {Bypassed_Mid_Band, "Bypassed Mid Band"},
-        {Bypassed_High_Band, "Bypassed High Band"},
-        
-        {Mute_Low_Band, "Mute Low Band"},
-        {Mute_Mid_Band, "Mute Mid Band"},
-        {Mute_High_Band, "Mute High Band"},
-        
-        {Solo_Low_Band, "Solo Low Band"},
-        {Solo_Mid_Band, "Solo Mid Band"},
-        {Solo_High_Band, "Solo High Band"},
-        
-        {Gain_in, "Gain_in"},
-        {Gain_out, "Gain_out"},
-    };
-    
-    return params;
+        static_assert(std::is_same_v<T, juce::AudioParameterBool>);
+        return Kind::Bool;
+    }
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+/**
+ the processor's parameter for 'name'. the layout adds the parameters in table order, so this
+ is an index into AudioProcessor::getParameters() rather than a search by ID.
+ */
+juce::RangedAudioParameter& getParam(const juce::AudioProcessor& processor, Names name);
+
+inline juce::RangedAudioParameter& getParam(const juce::AudioProcessorValueTreeState& apvts, Names name)
+{
+    return getParam(apvts.processor, name);
+}
+
+template<Names name>
+ParamType<name>& getParam(const juce::AudioProcessor& processor)
+{
+    return static_cast<ParamType<name>&>(getParam(processor, name));
+}
+
+/**
+ points 'param' at the parameter for 'name', for names only known at run time
+ */
+template<typename T>
+void bind(T*& param, const juce::AudioProcessor& processor, Names name)
+{
+    jassert(getSpec(name).kind == getKind<T>());
+    param = static_cast<T*>(&getParam(processor, name));
+}
+
+template<typename Attachment, typename Control>
+void makeAttachment(std::unique_ptr<Attachment>& attachment,
+                    juce::AudioProcessorValueTreeState& apvts,
+                    Names name,
+                    Control& control)
+{
+    attachment = std::make_unique<Attachment>(apvts, getId(name), control);
 }
 }
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 21 Oct 2026 3:48:12pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+namespace
+{
+constexpr juce::uint32 magic = 0x4243424d; // "MBCB"
+constexpr juce::uint16 version = 1;
+constexpr int headerSize = 16;
+constexpr int defaultNameSize = 32;
+}
+
+juce::File PresetBank::getDefaultFile()
+{
+    auto path = juce::SystemStats::getEnvironmentVariable("MULTIBAND_PRESET_BANK", {});
+    if( path.isNotEmpty() )
+        return juce::File(path);
+    
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("MultibandCompressor")
+               .getChildFile("Presets.mbcbank");
+}
+
+juce::Result PresetBank::open(const juce::File& file)
+{
+    mapping.reset();
+    numPresets = numValues = nameSize = 0;
+    
+    if( !file.existsAsFile() )
+        return juce::Result::fail("no preset bank at " + file.getFullPathName());
+    
+    auto newMapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    auto* bytes = static_cast<const juce::uint8*>(newMapping->getData());
+    auto size = newMapping->getSize();
+    
+    if( bytes == nullptr || size < (size_t)headerSize || juce::ByteOrder::littleEndianInt(bytes) != magic )
+        return juce::Result::fail(file.getFullPathName() + " isn't a preset bank");
+    
+    //every version so far has this layout. a later one that changes it would be migrated here.
+    auto fileVersion = juce::ByteOrder::littleEndianShort(bytes + 4);
+    if( fileVersion == 0 || fileVersion > version )
+        return juce::Result::fail(file.getFullPathName() + " has version " + juce::String(fileVersion) + ", which this build can't read");
+    
+    auto values = (int)juce::ByteOrder::littleEndianShort(bytes + 6);
+    auto presets = (juce::int64)juce::ByteOrder::littleEndianInt(bytes + 8);
+    auto names = (juce::int64)juce::ByteOrder::littleEndianInt(bytes + 12);
+    
+    auto recordSize = names + values * (juce::int64)sizeof(float);
+    if( names > 1024 || (juce::int64)size < headerSize + presets * recordSize )
+        return juce::Result::fail(file.getFullPathName() + " is truncated or corrupt");
+    
+    mapping = std::move(newMapping);
+    numPresets = (int)presets;
+    numValues = values;
+    nameSize = (int)names;
+    
+    return juce::Result::ok();
+}
+
+const juce::uint8* PresetBank::getRecord(int index) const noexcept
+{
+    if( mapping == nullptr || !juce::isPositiveAndBelow(index, numPresets) )
+        return nullptr;
+    
+    auto recordSize = (size_t)nameSize + (size_t)numValues * sizeof(float);
+    return static_cast<const juce::uint8*>(mapping->getData()) + headerSize + (size_t)index * recordSize;
+}
+
+juce::String PresetBank::getName(int index) const
+{
+    auto* record = getRecord(index);
+    if( record == nullptr )
+        return {};
+    
+    auto* name = reinterpret_cast<const char*>(record);
+    size_t length = 0;
+    while( length < (size_t)nameSize && name[length] != 0 )
+        ++length;
+    
+    return juce::String::fromUTF8(name, (int)length);
+}
+
+bool PresetBank::apply(int index, const ParameterState::Parameters& parameters) const
+{
+    auto* record = getRecord(index);
+    if( record == nullptr )
+        return false;
+    
+    ParameterState::applyValues(parameters, record + nameSize, numValues);
+    return true;
+}
+
+juce::Result PresetBank::write(const juce::File& file, const std::vector<Preset>& presets)
+{
+    juce::MemoryOutputStream out;
+    
+    out.writeInt((int)magic);
+    out.writeShort((short)version);
+    out.writeShort((short)Params::NumParams);
+    out.writeInt((int)presets.size());
+    out.writeInt(defaultNameSize);
+    
+    for( const auto& preset : presets )
+    {
+        //names are cut to fit, on a character boundary
+        char name[defaultNameSize] {};
+        preset.name.copyToUTF8(name, defaultNameSize);
+        out.write(name, defaultNameSize);
+        
+        for( auto value : preset.values )
+            out.writeFloat(value);
+    }
+    
+    if( file.getParentDirectory().createDirectory().failed() || !file.replaceWithData(out.getData(), out.getDataSize()) )
+        return juce::Result::fail("couldn't write " + file.getFullPathName());
+    
+    return juce::Result::ok();
+}
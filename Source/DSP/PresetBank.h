@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 21 Oct 2026 3:48:12pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+#include "ParameterState.h"
+
+/**
+ a read-only bank of presets in one memory-mapped file, shown to the host as its programs.
+ 
+ the file is a 16 byte header, a 4 byte magic, a 16 bit version, a 16 bit value count, a 32 bit
+ preset count and a 32 bit name size, then one fixed size record per preset. a record is the
+ preset's name as zero padded UTF-8 followed by its values laid out as
+ ParameterState::writeValues() writes them, so recalling a preset is an offset into the mapping
+ and nothing is parsed. everything is little endian.
+ */
+struct PresetBank
+{
+    /**
+     the bank every instance opens, $MULTIBAND_PRESET_BANK if it's set, otherwise
+     Presets.mbcbank in the user's application data folder
+     */
+    static juce::File getDefaultFile();
+    
+    /**
+     maps 'file'. a missing or malformed file, or one from a newer version, leaves the bank empty.
+     */
+    juce::Result open(const juce::File& file);
+    
+    int getNumPresets() const noexcept { return numPresets; }
+    
+    juce::String getName(int index) const;
+    
+    /**
+     sets every parameter from preset 'index'. returns false if there's no such preset.
+     */
+    bool apply(int index, const ParameterState::Parameters& parameters) const;
+    
+    struct Preset
+    {
+        juce::String name;
+        std::array<float, Params::NumParams> values {}; //in Params::Names order, in each parameter's own units
+    };
+    
+    static juce::Result write(const juce::File& file, const std::vector<Preset>& presets);
+    
+private:
+    const juce::uint8* getRecord(int index) const noexcept;
+    
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    int numPresets {0};
+    int numValues {0};
+    int nameSize {0};
+};
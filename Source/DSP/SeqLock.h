@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    SeqLock.h
+    Created: 21 Oct 2026 3:48:12pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ lets a writer change several atomics as one update without the reader ever waiting.
+ 
+ the writer makes the sequence odd while it writes and even again when it's done. the reader
+ notes the sequence, reads, and checks it didn't change. a reader that overlapped a write is
+ told so instead of retrying, the audio thread would rather keep what it had for one more block.
+ the values themselves must still be atomics, this only says whether they belong together.
+ */
+struct SeqLock
+{
+    struct ScopedWrite
+    {
+        explicit ScopedWrite(SeqLock& l) noexcept : lock(l) { lock.beginWrite(); }
+        ~ScopedWrite() noexcept { lock.endWrite(); }
+        
+        SeqLock& lock;
+    };
+    
+    /**
+     calls 'read' and returns true if no write overlapped it. returns false without calling
+     'read' if a write is already in progress.
+     */
+    template<typename ReadFunction>
+    bool tryRead(ReadFunction&& read) const noexcept
+    {
+        auto before = sequence.load(std::memory_order_acquire);
+        if( before & 1 )
+            return false;
+        
+        read();
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+    
+private:
+    //one writer at a time
+    void beginWrite() noexcept
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    void endWrite() noexcept
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    std::atomic<std::uint32_t> sequence {0};
+};
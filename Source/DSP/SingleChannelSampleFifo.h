@@ -30,8 +30,11 @@ struct SingleChannelSampleFifo
     void update(const BlockType& buffer)
     {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse );
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(buffer.getNumChannels() > 0);
+        
+        //a mono layout feeds the same channel to both fifos
+        auto channel = juce::jmin((int)channelToUse, buffer.getNumChannels() - 1);
+        auto* channelPtr = buffer.getReadPointer(channel);
         
         for( int i = 0; i < buffer.getNumSamples(); ++i )
         {
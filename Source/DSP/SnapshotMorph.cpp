@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    SnapshotMorph.cpp
+    Created: 21 Oct 2026 6:12:09pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "SnapshotMorph.h"
+
+namespace
+{
+constexpr juce::uint32 magic = 0x4d43424d; // "MBCM"
+
+enum class Interpolation
+{
+    None,
+    Linear,
+    Geometric,
+    Ratio
+};
+
+Interpolation getInterpolation(Params::Names name) noexcept
+{
+    using namespace Params;
+    
+    switch( name )
+    {
+        case Threshold_Low_Band:
+        case Threshold_Mid_Band:
+        case Threshold_High_Band:
+        case Gain_in:
+        case Gain_out:
+        case True_Peak_Ceiling:
+            return Interpolation::Linear;
+            
+        case Low_Mid_Crossover_Freq:
+        case Mid_High_Crossover_Freq:
+        case Attack_Low_Band:
+        case Attack_Mid_Band:
+        case Attack_High_Band:
+        case Release_Low_Band:
+        case Release_Mid_Band:
+        case Release_High_Band:
+            return Interpolation::Geometric;
+            
+        case Ratio_Low_Band:
+        case Ratio_Mid_Band:
+        case Ratio_High_Band:
+            return Interpolation::Ratio;
+            
+        default:
+            return Interpolation::None;
+    }
+}
+
+float toRatio(float choiceIndex) noexcept
+{
+    auto index = juce::jlimit(0, (int)Params::ratioChoices.size() - 1, juce::roundToInt(choiceIndex));
+    return Params::ratioChoices[(size_t)index];
+}
+
+float interpolateGeometric(float a, float b, float t) noexcept
+{
+    if( a <= 0.f || b <= 0.f )
+        return a + (b - a) * t;
+    
+    return a * std::pow(b / a, t);
+}
+}
+
+void SnapshotMorph::store(int snapshot, const ParameterState::Parameters& parameters)
+{
+    jassert(juce::isPositiveAndBelow(snapshot, numSnapshots));
+    
+    SeqLock::ScopedWrite write(lock);
+    
+    for( size_t i = 0; i < parameters.size(); ++i )
+        stored[(size_t)snapshot][i].store(parameters[i]->convertFrom0to1(parameters[i]->getValue()), std::memory_order_relaxed);
+    
+    storedFlags[(size_t)snapshot].store(true, std::memory_order_relaxed);
+}
+
+void SnapshotMorph::clear()
+{
+    //the values stay, so the processor can ramp from them back to the knobs
+    SeqLock::ScopedWrite write(lock);
+    
+    for( auto& flag : storedFlags )
+        flag.store(false, std::memory_order_relaxed);
+}
+
+bool SnapshotMorph::isStored(int snapshot) const noexcept
+{
+    return juce::isPositiveAndBelow(snapshot, numSnapshots) && storedFlags[(size_t)snapshot].load(std::memory_order_relaxed);
+}
+
+bool SnapshotMorph::isEngaged() const noexcept
+{
+    for( int s = 0; s < numSnapshots; ++s )
+    {
+        if( !isStored(s) )
+            return false;
+    }
+    
+    return true;
+}
+
+bool SnapshotMorph::update() noexcept
+{
+    //read into temporaries, a read that overlapped a store is thrown away and last block's copy kept
+    std::array<Values, numSnapshots> copies;
+    auto copiesAllStored = true;
+    
+    auto consistent = lock.tryRead([this, &copies, &copiesAllStored]
+    {
+        for( size_t s = 0; s < (size_t)numSnapshots; ++s )
+        {
+            copiesAllStored = copiesAllStored && storedFlags[s].load(std::memory_order_relaxed);
+            
+            for( size_t i = 0; i < copies[s].size(); ++i )
+                copies[s][i] = stored[s][i].load(std::memory_order_relaxed);
+        }
+    });
+    
+    if( consistent )
+    {
+        snapshots = copies;
+        allStored = copiesAllStored;
+    }
+    
+    return allStored;
+}
+
+bool SnapshotMorph::isMorphed(Params::Names name) noexcept
+{
+    return getInterpolation(name) != Interpolation::None;
+}
+
+float SnapshotMorph::getValue(Params::Names name, float position) const noexcept
+{
+    //with more than two snapshots the position moves through each pair in turn
+    auto scaled = juce::jlimit(0.f, 1.f, position) * float(numSnapshots - 1);
+    auto first = juce::jmin((int)scaled, numSnapshots - 2);
+    auto t = scaled - float(first);
+    
+    auto a = snapshots[(size_t)first][(size_t)name];
+    auto b = snapshots[(size_t)first + 1][(size_t)name];
+    
+    //the snapshots hold the ratios as choice indices
+    if( getInterpolation(name) == Interpolation::Ratio )
+        return interpolate(name, toRatio(a), toRatio(b), t);
+    
+    return interpolate(name, a, b, t);
+}
+
+float SnapshotMorph::interpolate(Params::Names name, float a, float b, float t) noexcept
+{
+    //the ends are exact, so a morph that's fully in or out gives exactly what it's set to
+    if( t <= 0.f )
+        return a;
+    
+    if( t >= 1.f )
+        return b;
+    
+    switch( getInterpolation(name) )
+    {
+        case Interpolation::Linear: return a + (b - a) * t;
+        case Interpolation::Geometric:
+        case Interpolation::Ratio: return interpolateGeometric(a, b, t);
+        case Interpolation::None: break;
+    }
+    
+    return t < 0.5f ? a : b;
+}
+
+void SnapshotMorph::write(juce::MemoryBlock& destData) const
+{
+    juce::MemoryOutputStream out(destData, true);
+    
+    out.writeInt((int)magic);
+    out.writeByte((char)numSnapshots);
+    out.writeShort((short)Params::NumParams);
+    
+    for( size_t s = 0; s < (size_t)numSnapshots; ++s )
+    {
+        out.writeBool(storedFlags[s].load());
+        
+        for( const auto& value : stored[s] )
+            out.writeFloat(value.load());
+    }
+}
+
+int SnapshotMorph::read(const ParameterState::Parameters& parameters, const void* data, int sizeInBytes)
+{
+    SeqLock::ScopedWrite write(lock);
+    
+    for( auto& flag : storedFlags )
+        flag.store(false);
+    
+    juce::MemoryInputStream in(data, data != nullptr ? (size_t)juce::jmax(0, sizeInBytes) : 0, false);
+    
+    if( in.getNumBytesRemaining() < 7 || (juce::uint32)in.readInt() != magic )
+        return 0;
+    
+    auto count = (int)(juce::uint8)in.readByte();
+    auto numValues = (int)(juce::uint16)in.readShort();
+    
+    if( in.getNumBytesRemaining() < (juce::int64)count * (1 + numValues * (juce::int64)sizeof(float)) )
+        return 0;
+    
+    auto getDefault = [&parameters](int i)
+    {
+        return parameters[(size_t)i]->convertFrom0to1(parameters[(size_t)i]->getDefaultValue());
+    };
+    
+    for( int s = 0; s < count; ++s )
+    {
+        auto isStoredSnapshot = in.readBool();
+        
+        for( int i = 0; i < numValues; ++i )
+        {
+            auto value = in.readFloat();
+            
+            if( s < numSnapshots && i < Params::NumParams )
+                stored[(size_t)s][(size_t)i].store(std::isfinite(value) ? value : getDefault(i));
+        }
+        
+        if( s < numSnapshots )
+        {
+            //parameters added since the state was saved
+            for( int i = numValues; i < Params::NumParams; ++i )
+                stored[(size_t)s][(size_t)i].store(getDefault(i));
+            
+            storedFlags[(size_t)s].store(isStoredSnapshot);
+        }
+    }
+    
+    return (int)in.getPosition();
+}
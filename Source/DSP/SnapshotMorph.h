@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    SnapshotMorph.h
+    Created: 21 Oct 2026 6:12:09pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+#include "ParameterState.h"
+#include "SeqLock.h"
+
+/**
+ stored A and B settings, and the settings part way between them.
+ 
+ the message thread stores the current parameter values as a snapshot. once every snapshot is
+ stored the processor takes the continuous parameters from here, at the position of the Morph
+ parameter, instead of from the parameters themselves, until the snapshots are cleared.
+ levels move linearly in dB, times and frequencies move geometrically so the middle of a morph
+ sounds like the middle, and ratios move geometrically between the values in
+ Params::ratioChoices rather than stepping through the choices. switches like bypass, mute and
+ solo aren't morphed and always come from the parameters.
+ */
+struct SnapshotMorph
+{
+    static constexpr int numSnapshots = 2;
+    
+    /**
+     message thread. copies every parameter's current value into 'snapshot'.
+     */
+    void store(int snapshot, const ParameterState::Parameters& parameters);
+    
+    /**
+     message thread. forgets every snapshot, which hands the continuous parameters back to
+     their own knobs.
+     */
+    void clear();
+    
+    bool isStored(int snapshot) const noexcept;
+    
+    /**
+     true if every snapshot is stored, so the morph overrides the continuous parameters
+     */
+    bool isEngaged() const noexcept;
+    
+    /**
+     audio thread, once per block. picks up snapshots stored since the last call and returns
+     true if every snapshot is stored, which is when the morph takes over.
+     */
+    bool update() noexcept;
+    
+    static bool isMorphed(Params::Names name) noexcept;
+    
+    /**
+     the value 't' of the way from 'a' to 'b', moving the way 'name' morphs. both are in the
+     parameter's own units, with the ratios as ratios rather than choice indices.
+     */
+    static float interpolate(Params::Names name, float a, float b, float t) noexcept;
+    
+    /**
+     audio thread. the value of 'name' at 'position', from 0 at the first snapshot to 1 at the
+     last, in the parameter's own units. for the ratios it's the ratio itself, not a choice index.
+     */
+    float getValue(Params::Names name, float position) const noexcept;
+    
+    /**
+     the snapshots for the saved state, appended after the parameter values
+     */
+    void write(juce::MemoryBlock& destData) const;
+    
+    /**
+     replaces the snapshots with what write() wrote and returns how many bytes it used. anything
+     else, including nothing at all, clears them and returns 0. values a snapshot doesn't have
+     are the parameters' defaults.
+     */
+    int read(const ParameterState::Parameters& parameters, const void* data, int sizeInBytes);
+    
+private:
+    using Values = std::array<float, Params::NumParams>;
+    
+    //written by the message thread inside a write on 'lock'
+    std::array<std::array<std::atomic<float>, Params::NumParams>, numSnapshots> stored {};
+    std::array<std::atomic<bool>, numSnapshots> storedFlags {};
+    SeqLock lock;
+    
+    //the audio thread's copy
+    std::array<Values, numSnapshots> snapshots {};
+    bool allStored {false};
+};
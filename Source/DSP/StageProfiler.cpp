@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 20 Oct 2026 4:12:53pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+const char* StageProfiler::getStageName(Stage stage) noexcept
+{
+    switch( stage )
+    {
+        case UpdateState: return "updateState";
+        case AnalyzerFifos: return "analyzerFifos";
+        case InputGain: return "inputGain";
+        case SplitBands: return "splitBands";
+        case CompressLow: return "compressLow";
+        case CompressMid: return "compressMid";
+        case CompressHigh: return "compressHigh";
+        case Sum: return "sum";
+        case OutputGain: return "outputGain";
+        case Limiter: return "limiter";
+        case Loudness: return "loudness";
+        case NumStages: break;
+    }
+    
+    return "";
+}
+
+int StageProfiler::getBucket(std::uint64_t ticks) noexcept
+{
+    //the octave is the position of the top bit, the sub bucket the bits just below it
+    if( ticks < (1u << subBucketBits) )
+        return (int)ticks;
+    
+    int topBit = 63;
+    while( (ticks >> topBit) == 0 )
+        --topBit;
+    
+    auto subBucket = int(ticks >> (topBit - subBucketBits)) & ((1 << subBucketBits) - 1);
+    return ((topBit - subBucketBits + 1) << subBucketBits) + subBucket;
+}
+
+double StageProfiler::getBucketUpperBound(int bucket) noexcept
+{
+    if( bucket < (1 << subBucketBits) )
+        return bucket;
+    
+    auto octave = (bucket >> subBucketBits) + subBucketBits - 1;
+    auto subBucket = bucket & ((1 << subBucketBits) - 1);
+    auto lowerBound = std::ldexp(1.0 + double(subBucket) / (1 << subBucketBits), octave);
+    
+    return lowerBound + std::ldexp(1.0, octave - subBucketBits) - 1.0;
+}
+
+void StageProfiler::Histogram::clear() noexcept
+{
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    min.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+    
+    for( auto& bucket : buckets )
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void StageProfiler::beginBlock() noexcept
+{
+    if( resetRequested.exchange(false, std::memory_order_acquire) )
+    {
+        for( auto& histogram : histograms )
+            histogram.clear();
+    }
+}
+
+void StageProfiler::record(Stage stage, std::uint64_t ticks) noexcept
+{
+    //single writer, so plain loads and stores are enough and nothing here can contend
+    auto& histogram = histograms[(size_t)stage];
+    auto count = histogram.count.load(std::memory_order_relaxed);
+    
+    if( count == 0 || ticks < histogram.min.load(std::memory_order_relaxed) )
+        histogram.min.store(ticks, std::memory_order_relaxed);
+    
+    if( ticks > histogram.max.load(std::memory_order_relaxed) )
+        histogram.max.store(ticks, std::memory_order_relaxed);
+    
+    auto& bucket = histogram.buckets[(size_t)getBucket(ticks)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    
+    histogram.total.store(histogram.total.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+    histogram.count.store(count + 1, std::memory_order_release);
+}
+
+StageProfiler::Summary StageProfiler::getSummary(Stage stage) const noexcept
+{
+    const auto& histogram = histograms[(size_t)stage];
+    
+    Summary summary;
+    summary.count = histogram.count.load(std::memory_order_acquire);
+    if( summary.count == 0 )
+        return summary;
+    
+    summary.min = double(histogram.min.load(std::memory_order_relaxed));
+    summary.max = double(histogram.max.load(std::memory_order_relaxed));
+    summary.mean = double(histogram.total.load(std::memory_order_relaxed)) / double(summary.count);
+    
+    //walk up the buckets until 99% of the blocks are below
+    const auto target = std::ceil(double(summary.count) * 0.99);
+    std::uint64_t seen = 0;
+    
+    for( int bucket = 0; bucket < numBuckets; ++bucket )
+    {
+        seen += histogram.buckets[(size_t)bucket].load(std::memory_order_relaxed);
+        if( double(seen) >= target )
+        {
+            summary.p99 = juce::jlimit(summary.min, summary.max, getBucketUpperBound(bucket));
+            break;
+        }
+    }
+    
+    return summary;
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 20 Oct 2026 4:12:53pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "CycleCounter.h"
+#include "TraceRecorder.h"
+
+/**
+ set MULTIBAND_STAGE_TIMING=1 in the project's preprocessor definitions to time each stage of
+ processBlock. at 0 the timers compile to nothing and the processor has no profiler.
+ */
+#ifndef MULTIBAND_STAGE_TIMING
+ #define MULTIBAND_STAGE_TIMING 0
+#endif
+
+/**
+ per stage histograms of processBlock timings in CycleCounter ticks.
+ 
+ the audio thread is the only writer, anything can read. each histogram has 4 buckets per octave,
+ so a percentile is good to within 25%, and min, max and mean are exact. the stages that run per
+sub-block (input gain to the limiter) are recorded once per sub-block, the rest once per host block.
+ */
+struct StageProfiler
+{
+    enum Stage
+    {
+        UpdateState,
+        AnalyzerFifos,
+        InputGain,
+        SplitBands,
+        CompressLow,
+        CompressMid,
+        CompressHigh,
+        Sum,
+        OutputGain,
+        Limiter,
+        Loudness,
+        
+        NumStages
+    };
+    
+    static const char* getStageName(Stage stage) noexcept;
+    
+    /**
+     call at the start of every block, it's where a reset() from another thread takes effect
+     */
+    void beginBlock() noexcept;
+    
+    void record(Stage stage, std::uint64_t ticks) noexcept;
+    
+    struct Summary
+    {
+        std::uint64_t count {0};
+        double min {0}, mean {0}, p99 {0}, max {0};
+    };
+    
+    /**
+     safe from any thread. a block being recorded at the same time may be half counted.
+     */
+    Summary getSummary(Stage stage) const noexcept;
+    
+    /**
+     clears every histogram before the next block
+     */
+    void reset() noexcept { resetRequested.store(true, std::memory_order_release); }
+    
+    struct ScopedTimer
+    {
+        ScopedTimer(StageProfiler& p, Stage s) noexcept : profiler(p), stage(s), start(CycleCounter::now()) { }
+        ~ScopedTimer() noexcept { profiler.record(stage, CycleCounter::now() - start); }
+        
+        StageProfiler& profiler;
+        const Stage stage;
+        const std::uint64_t start;
+    };
+    
+private:
+    static constexpr int subBucketBits = 2;
+    static constexpr int numBuckets = 64 << subBucketBits;
+    
+    static int getBucket(std::uint64_t ticks) noexcept;
+    static double getBucketUpperBound(int bucket) noexcept;
+    
+    struct Histogram
+    {
+        std::atomic<std::uint64_t> count {0}, total {0}, min {0}, max {0};
+        std::array<std::atomic<std::uint64_t>, numBuckets> buckets {};
+        
+        void clear() noexcept;
+    };
+    
+    std::array<Histogram, NumStages> histograms;
+    std::atomic<bool> resetRequested {false};
+};
+
+/**
+ times a stage into the profiler with MULTIBAND_STAGE_TIMING, and traces it with MULTIBAND_TRACING.
+ 'stage' is a Stage name, or an expression of them like CompressLow + band.
+ */
+#if MULTIBAND_STAGE_TIMING
+ #define MULTIBAND_STAGE_TIMER(profiler, stage) \
+    StageProfiler::ScopedTimer JUCE_JOIN_MACRO(stageTimer_, __LINE__) (profiler, stage);
+#else
+ #define MULTIBAND_STAGE_TIMER(profiler, stage)
+#endif
+
+#if MULTIBAND_TRACING
+ #define MULTIBAND_STAGE_TRACE(stage) \
+    TraceRecorder::ScopedEvent JUCE_JOIN_MACRO(stageTrace_, __LINE__) (StageProfiler::getStageName(stage));
+#else
+ #define MULTIBAND_STAGE_TRACE(stage)
+#endif
+
+#define MULTIBAND_TIME_STAGE(profiler, stage) \
+    MULTIBAND_STAGE_TIMER(profiler, StageProfiler::Stage(StageProfiler::stage)) \
+    MULTIBAND_STAGE_TRACE(StageProfiler::Stage(StageProfiler::stage))
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 20 Oct 2026 8:31:19pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+std::atomic<TraceRecorder*> TraceRecorder::current {nullptr};
+std::atomic<juce::uint32> TraceRecorder::nextGeneration {1};
+thread_local TraceRecorder::ThreadClaim TraceRecorder::threadClaim;
+
+TraceRecorder::ThreadClaim::~ThreadClaim()
+{
+    //if the recorder has gone already this ring is the last of it, and is freed here
+    if( buffer != nullptr )
+        buffer->finished.store(true, std::memory_order_release);
+}
+
+TraceRecorder::TraceRecorder() :
+generation(nextGeneration.fetch_add(1))
+{
+    for( auto& thread : threads )
+    {
+        thread = std::make_shared<ThreadBuffer>();
+        thread->events = std::make_unique<Event[]>(eventsPerThread);
+    }
+    
+    current.store(this);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    current.store(nullptr);
+    stop();
+}
+
+bool TraceRecorder::start(const juce::File& file)
+{
+    //nothing records while this runs, so the rings can be reset safely
+    if( isRecording() )
+        return false;
+    
+    file.deleteFile();
+    output = std::make_unique<juce::FileOutputStream>(file);
+    if( output->failedToOpen() )
+    {
+        output.reset();
+        return false;
+    }
+    
+    for( auto& thread : threads )
+    {
+        thread->fifo.reset();
+        thread->named.store(false);
+        thread->dropped.store(0);
+        
+        //threads that exited since the last recording don't need their rings any more
+        if( thread->finished.exchange(false) )
+            thread->claimed.store(false);
+    }
+    
+    firstEvent = true;
+    output->writeText("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", false, false, nullptr);
+    
+    startTicks = juce::Time::getHighResolutionTicks();
+    recording.store(true);
+    writer.startThread();
+    
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if( !recording.exchange(false) )
+        return;
+    
+    //the writer drains whatever's left before it exits
+    writer.stopThread(2000);
+    
+    output->writeText("\n]}\n", false, false, nullptr);
+    output->flush();
+    output.reset();
+}
+
+void TraceRecorder::begin(const char* name) noexcept { record(name, true); }
+void TraceRecorder::end(const char* name) noexcept { record(name, false); }
+
+void TraceRecorder::record(const char* name, bool isBegin) noexcept
+{
+    auto* recorder = current.load(std::memory_order_acquire);
+    if( recorder == nullptr || !recorder->isRecording() )
+        return;
+    
+    auto* buffer = recorder->getBufferForThisThread();
+    if( buffer == nullptr )
+        return;
+    
+    auto write = buffer->fifo.write(1);
+    if( write.blockSize1 > 0 )
+        buffer->events[(size_t)write.startIndex1] = { name, juce::Time::getHighResolutionTicks(), isBegin };
+    else
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::getBufferForThisThread() noexcept
+{
+    if( threadClaim.generation == generation )
+        return threadClaim.buffer.get();
+    
+    //a ring left over from an earlier recorder is let go of here, and freed if that recorder has gone
+    threadClaim.generation = generation;
+    threadClaim.buffer.reset();
+    
+    for( auto& thread : threads )
+    {
+        if( !thread->claimed.exchange(true) )
+        {
+            //stored before any event, so the writer sees it once it sees the first one
+            thread->isMessageThread.store(juce::MessageManager::existsAndIsCurrentThread());
+            threadClaim.buffer = thread;
+            break;
+        }
+    }
+    
+    //a thread that found no free ring doesn't look again
+    return threadClaim.buffer.get();
+}
+
+void TraceRecorder::Writer::run()
+{
+    while( !threadShouldExit() )
+    {
+        recorder.writePendingEvents();
+        wait(50);
+    }
+    
+    recorder.writePendingEvents();
+}
+
+void TraceRecorder::writePendingEvents()
+{
+    using namespace juce;
+    
+    auto writeEvent = [this](const String& json)
+    {
+        if( !firstEvent )
+            output->writeText(",\n", false, false, nullptr);
+        
+        output->writeText(json, false, false, nullptr);
+        firstEvent = false;
+    };
+    
+    const auto ticksPerMicrosecond = double(Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+    
+    for( size_t tid = 0; tid < threads.size(); ++tid )
+    {
+        auto& thread = *threads[tid];
+        if( !thread.claimed.load() )
+            continue;
+        
+        //read before draining, so everything the exited thread wrote is written out below
+        auto finished = thread.finished.load(std::memory_order_acquire);
+        auto numReady = thread.fifo.getNumReady();
+        
+        //named once its first events are in, which were written after isMessageThread was
+        if( numReady > 0 && !thread.named.load() )
+        {
+            auto name = thread.isMessageThread.load() ? String("message thread") : "thread " + String(tid);
+            writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + String(tid)
+                       + ",\"args\":{\"name\":\"" + name + "\"}}");
+            thread.named.store(true);
+        }
+        
+        auto read = thread.fifo.read(numReady);
+        
+        auto writeRange = [&](int start, int size)
+        {
+            for( int i = start; i < start + size; ++i )
+            {
+                const auto& event = thread.events[(size_t)i];
+                auto micros = double(event.ticks - startTicks) / ticksPerMicrosecond;
+                
+                writeEvent("{\"name\":\"" + String(event.name) + "\",\"ph\":\"" + (event.isBegin ? "B" : "E")
+                           + "\",\"ts\":" + String(micros, 3) + ",\"pid\":1,\"tid\":" + String(tid) + "}");
+            }
+        };
+        
+        writeRange(read.startIndex1, read.blockSize1);
+        writeRange(read.startIndex2, read.blockSize2);
+        
+        //dropped events show up as instant markers, so the gap in the timeline is explained
+        if( auto dropped = thread.dropped.exchange(0) )
+        {
+            auto micros = double(Time::getHighResolutionTicks() - startTicks) / ticksPerMicrosecond;
+            writeEvent("{\"name\":\"dropped " + String(dropped) + " events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":"
+                       + String(micros, 3) + ",\"pid\":1,\"tid\":" + String(tid) + "}");
+        }
+        
+        //the next thread to claim it is named afresh on the same track
+        if( finished )
+        {
+            thread.named.store(false);
+            thread.finished.store(false);
+            thread.claimed.store(false, std::memory_order_release);
+        }
+    }
+    
+    output->flush();
+}
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 20 Oct 2026 8:31:19pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ set MULTIBAND_TRACING=1 in the project's preprocessor definitions to compile in the trace points.
+ at 0 MULTIBAND_TRACE_SCOPE compiles to nothing.
+ */
+#ifndef MULTIBAND_TRACING
+ #define MULTIBAND_TRACING 0
+#endif
+
+/**
+ records begin and end events from any thread into a timeline file in the Chrome trace JSON format,
+ which chrome://tracing and ui.perfetto.dev both open.
+ 
+ each thread writes into its own preallocated single producer ring, so recording an event is a
+ couple of atomic operations and never allocates or locks. a background thread drains the rings
+ and writes the file. events are dropped, and counted, if a ring fills up before it's drained.
+ a thread's ring is handed back for reuse once the thread exits and its events are written.
+ 
+ the recorder is shared through juce::SharedResourcePointer. the file is finished when stop() is
+ called or the last pointer to the recorder goes away.
+ */
+struct TraceRecorder
+{
+    TraceRecorder();
+    ~TraceRecorder();
+    
+    /**
+     starts writing a new timeline to 'file'. returns false if it's already recording or the file
+     can't be written.
+     */
+    bool start(const juce::File& file);
+    void stop();
+    
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+    
+    /**
+     'name' has to outlive the recording, in practice it's a string literal
+     */
+    static void begin(const char* name) noexcept;
+    static void end(const char* name) noexcept;
+    
+    struct ScopedEvent
+    {
+        explicit ScopedEvent(const char* eventName) noexcept : name(eventName) { begin(name); }
+        ~ScopedEvent() noexcept { end(name); }
+        
+        const char* const name;
+    };
+    
+private:
+    struct Event
+    {
+        const char* name;
+        juce::int64 ticks;
+        bool isBegin;
+    };
+    
+    //threads that record while all of these are taken lose their events
+    static constexpr int maxThreads = 32;
+    static constexpr int eventsPerThread = 1 << 15;
+    
+    struct ThreadBuffer
+    {
+        std::atomic<bool> claimed {false};
+        std::atomic<bool> finished {false}; //its thread has exited, so it's free once drained
+        std::atomic<bool> isMessageThread {false};
+        std::atomic<bool> named {false};
+        juce::AbstractFifo fifo {eventsPerThread};
+        std::unique_ptr<Event[]> events;
+        std::atomic<juce::uint32> dropped {0};
+    };
+    
+    static void record(const char* name, bool isBegin) noexcept;
+    ThreadBuffer* getBufferForThisThread() noexcept;
+    
+    /**
+     the ring this thread claimed and the recorder it came from. a recorder is known by its generation
+     rather than its address, which a later recorder could be allocated at.
+     the claim shares ownership of the ring, so the destructor can hand it back when the thread exits
+     without touching the recorder, which may be going away at the same time.
+     */
+    struct ThreadClaim
+    {
+        ~ThreadClaim();
+        
+        juce::uint32 generation {0};
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+    
+    static thread_local ThreadClaim threadClaim;
+    
+    struct Writer : juce::Thread
+    {
+        Writer(TraceRecorder& r) : juce::Thread("TraceRecorder"), recorder(r) { }
+        void run() override;
+        
+        TraceRecorder& recorder;
+    };
+    
+    void writePendingEvents();
+    
+    std::array<std::shared_ptr<ThreadBuffer>, maxThreads> threads;
+    std::atomic<bool> recording {false};
+    juce::int64 startTicks {0};
+    
+    Writer writer {*this};
+    std::unique_ptr<juce::FileOutputStream> output;
+    bool firstEvent {true};
+    
+    static std::atomic<TraceRecorder*> current;
+    static std::atomic<juce::uint32> nextGeneration;
+    const juce::uint32 generation;
+    
+    JUCE_DECLARE_NON_COPYABLE(TraceRecorder)
+};
+
+#if MULTIBAND_TRACING
+ #define MULTIBAND_TRACE_SCOPE(name) TraceRecorder::ScopedEvent JUCE_JOIN_MACRO(traceEvent_, __LINE__) (name)
+#else
+ #define MULTIBAND_TRACE_SCOPE(name)
+#endif
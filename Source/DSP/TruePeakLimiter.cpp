@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.cpp
+    Created: 19 Oct 2026 8:21:47pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "TruePeakLimiter.h"
+
+void TruePeakLimiter::prepare(double sampleRate, int newNumChannels, int maximumBlockSize)
+{
+    //48 tap windowed sinc at the original Nyquist, split into 4 phases of 12.
+    //each phase is normalised to unity gain at DC so a steady signal reads the same on every phase.
+    constexpr int numTaps = oversampling * tapsPerPhase;
+    constexpr auto centre = (numTaps - 1) / 2.0;
+    
+    for( int phase = 0; phase < oversampling; ++phase )
+    {
+        auto& coefficients = phaseCoefficients[(size_t)phase];
+        auto sum = 0.0;
+        
+        for( int k = 0; k < tapsPerPhase; ++k )
+        {
+            auto n = phase + k * oversampling;
+            auto x = (n - centre) / oversampling;
+            auto sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            
+            //4 term Blackman-Harris
+            auto w = juce::MathConstants<double>::twoPi * (n + 0.5) / numTaps;
+            auto window = 0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2 * w) - 0.01168 * std::cos(3 * w);
+            
+            coefficients[(size_t)k] = float(sinc * window);
+            sum += sinc * window;
+        }
+        
+        for( auto& c : coefficients )
+            c = float(c / sum);
+    }
+    
+    numChannels = newNumChannels;
+    maxBlockSize = juce::jmax(1, maximumBlockSize);
+    
+    //1.5 ms lookahead, 50 ms release
+    lookaheadSamples = juce::jmax(1, juce::roundToInt(0.0015 * sampleRate));
+    releaseCoefficient = float(std::exp(-1.0 / (0.05 * sampleRate)));
+    enabledAmountStep = float(1.0 / juce::jmax(1.0, toggleRampSeconds * sampleRate));
+    
+    interpolatorInput.setSize(numChannels, tapsPerPhase - 1 + maxBlockSize);
+    interpolatorInput.clear();
+    phaseOutput.assign((size_t)maxBlockSize, 0.f);
+    blockTruePeak.assign((size_t)maxBlockSize, 0.f);
+    
+    delayLine.setSize(numChannels, getLatencySamples());
+    delayLine.clear();
+    peakDelayLine.assign((size_t)lookaheadSamples, 0.f);
+    delayPosition = 0;
+    peakDelayPosition = 0;
+    
+    requiredGainHold.prepare(lookaheadSamples + 1);
+    smoothingRing.assign((size_t)lookaheadSamples, 1.f);
+    resetLimiter();
+    enabledAmount = 0.f;
+    running = false;
+    freshlyPrepared = true;
+    
+    maxTruePeak.store(0.f);
+    gainReductionDb.store(0.f);
+}
+
+void TruePeakLimiter::process(juce::AudioBuffer<float>& buffer)
+{
+    if( peakResetRequested.exchange(false) )
+        maxTruePeak.store(0.f);
+    
+    jassert(buffer.getNumChannels() >= numChannels);
+    
+    //hosts are allowed to go over the block size they announced, so work through it in pieces
+    auto numSamples = buffer.getNumSamples();
+    for( int start = 0; start < numSamples; start += maxBlockSize )
+    {
+        processChunk(buffer, start, juce::jmin(maxBlockSize, numSamples - start));
+    }
+}
+
+void TruePeakLimiter::detectTruePeaks(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    using FVO = juce::FloatVectorOperations;
+    
+    auto* peaks = blockTruePeak.data();
+    auto* out = phaseOutput.data();
+    FVO::clear(peaks, numSamples);
+    
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        auto* input = interpolatorInput.getWritePointer(ch);
+        FVO::copy(input + tapsPerPhase - 1, buffer.getReadPointer(ch, startSample), numSamples);
+        
+        //each phase is a 12 tap FIR over the block. running it tap by tap keeps every step a long
+        //contiguous multiply-add, which is what FloatVectorOperations vectorises best.
+        for( const auto& coefficients : phaseCoefficients )
+        {
+            FVO::multiply(out, input + tapsPerPhase - 1, coefficients[0], numSamples);
+            
+            for( int k = 1; k < tapsPerPhase; ++k )
+                FVO::addWithMultiply(out, input + tapsPerPhase - 1 - k, coefficients[(size_t)k], numSamples);
+            
+            FVO::abs(out, out, numSamples);
+            FVO::max(peaks, peaks, out, numSamples);
+        }
+        
+        //keep the tail as history for the next block
+        std::copy(input + numSamples, input + numSamples + tapsPerPhase - 1, input);
+    }
+}
+
+void TruePeakLimiter::resetLimiter()
+{
+    requiredGainHold.reset();
+    envelope = 1.f;
+    std::fill(smoothingRing.begin(), smoothingRing.end(), 1.f);
+    smoothingSum = lookaheadSamples;
+    smoothingPosition = 0;
+}
+
+void TruePeakLimiter::processChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    detectTruePeaks(buffer, startSample, numSamples);
+    
+    //what the limiter held from the last time it was on would dip the gain for no reason
+    if( enabled && !running )
+    {
+        resetLimiter();
+        running = true;
+        
+        //a limiter that's on from the start of playback has nothing to fade in from
+        if( freshlyPrepared )
+            enabledAmount = 1.f;
+    }
+    
+    freshlyPrepared = false;
+    
+    const auto latency = getLatencySamples();
+    const auto targetAmount = enabled ? 1.f : 0.f;
+    auto minGain = 1.f;
+    auto maxOutputPeak = maxTruePeak.load();
+    
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto peak = blockTruePeak[(size_t)i];
+        auto gain = 1.f;
+        
+        if( running )
+        {
+            //the gain each peak needs is held across the lookahead, released exponentially, then
+            //averaged over the lookahead so it has fully ramped down by the time the peak comes out
+            auto required = peak > ceilingGain ? ceilingGain / peak : 1.f;
+            auto held = requiredGainHold.push(required);
+            
+            envelope = held < envelope ? held : held + (envelope - held) * releaseCoefficient;
+            
+            smoothingSum += envelope - smoothingRing[(size_t)smoothingPosition];
+            smoothingRing[(size_t)smoothingPosition] = envelope;
+            smoothingPosition = (smoothingPosition + 1) % lookaheadSamples;
+            
+            auto limiterGain = juce::jmin(1.f, float(smoothingSum / lookaheadSamples));
+            
+            enabledAmount = targetAmount > enabledAmount ? juce::jmin(targetAmount, enabledAmount + enabledAmountStep)
+                                                         : juce::jmax(targetAmount, enabledAmount - enabledAmountStep);
+            gain = 1.f + enabledAmount * (limiterGain - 1.f);
+        }
+        
+        //peaks are detected 'interpolatorDelay' samples late, so they only need the lookahead
+        auto& delayedPeak = peakDelayLine[(size_t)peakDelayPosition];
+        maxOutputPeak = juce::jmax(maxOutputPeak, delayedPeak * gain);
+        delayedPeak = peak;
+        peakDelayPosition = (peakDelayPosition + 1) % lookaheadSamples;
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            auto& delayed = delayLine.getWritePointer(ch)[delayPosition];
+            auto& sample = buffer.getWritePointer(ch)[startSample + i];
+            
+            auto input = sample;
+            sample = delayed * gain;
+            delayed = input;
+        }
+        
+        delayPosition = (delayPosition + 1) % latency;
+        minGain = juce::jmin(minGain, gain);
+    }
+    
+    //fully faded out, so it can stop until it's next enabled
+    if( !enabled && enabledAmount <= 0.f )
+    {
+        running = false;
+    }
+    
+    maxTruePeak.store(maxOutputPeak);
+    gainReductionDb.store(juce::Decibels::gainToDecibels(minGain));
+}
+
+void TruePeakLimiter::SlidingMinimum::prepare(int windowLength)
+{
+    length = juce::jmax(1, windowLength);
+    queue.assign((size_t)length, { 0, 1.f });
+    reset();
+}
+
+void TruePeakLimiter::SlidingMinimum::reset()
+{
+    head = 0;
+    size = 0;
+    index = 0;
+}
+
+float TruePeakLimiter::SlidingMinimum::push(float value)
+{
+    auto slot = [this](int offset) -> std::pair<std::int64_t, float>&
+    {
+        return queue[(size_t)((head + offset) % length)];
+    };
+    
+    //drop what slides out of the window, which is at most the front entry
+    if( size > 0 && slot(0).first <= index - length )
+    {
+        head = (head + 1) % length;
+        --size;
+    }
+    
+    //anything at least as large as the new value can never be the minimum again
+    while( size > 0 && slot(size - 1).second >= value )
+        --size;
+    
+    slot(size) = { index, value };
+    ++size;
+    
+    ++index;
+    return slot(0).second;
+}
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.h
+    Created: 19 Oct 2026 8:21:47pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ inter-sample true-peak meter with an optional lookahead limiter, both driven by one
+ 4x polyphase interpolation of the signal (ITU-R BS.1770 annex 2).
+ 
+ the interpolator works a phase at a time over the whole block with FloatVectorOperations, and the
+ limiter reads the per-sample true peak it leaves behind, so turning the limiter on costs no extra
+ oversampling. the output is always delayed by getLatencySamples(), whether the limiter is on or not,
+ so toggling it never changes the latency the host compensates for. toggling crossfades between the
+ limited and the unlimited gain over toggleRampSeconds, so switching off mid-limit doesn't click.
+ */
+struct TruePeakLimiter
+{
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr double toggleRampSeconds = 0.02;
+    
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize);
+    void process(juce::AudioBuffer<float>& buffer);
+    
+    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    void setCeilingDb(float newCeilingDb) { ceilingGain = juce::Decibels::decibelsToGain(newCeilingDb); }
+    
+    int getLatencySamples() const { return lookaheadSamples + interpolatorDelay; }
+    
+    /**
+     highest true peak of the output since the last resetPeak(), in dBTP
+     */
+    float getMaxTruePeakDb() const { return juce::Decibels::gainToDecibels(maxTruePeak.load(), -100.f); }
+    void resetPeak() { peakResetRequested.store(true); }
+    
+    /**
+     the limiter's deepest gain reduction during the last block, <= 0
+     */
+    float getGainReductionDb() const { return gainReductionDb.load(); }
+    
+private:
+    //the interpolator's group delay in input samples, rounded up
+    static constexpr int interpolatorDelay = tapsPerPhase / 2;
+    
+    std::array<std::array<float, tapsPerPhase>, oversampling> phaseCoefficients;
+    
+    int numChannels {0};
+    int maxBlockSize {0};
+    int lookaheadSamples {1};
+    float releaseCoefficient {0.f};
+    
+    bool enabled {false};
+    float ceilingGain {1.f};
+    
+    //how much of the limiter's gain is applied, ramped towards 1 when enabled and 0 when not.
+    //the limiter only runs while this is above 0, and starts from a clean state when it's next enabled.
+    float enabledAmount {0.f};
+    float enabledAmountStep {0.f};
+    bool running {false};
+    bool freshlyPrepared {true};
+    
+    //each channel's last tapsPerPhase - 1 samples followed by the current block
+    juce::AudioBuffer<float> interpolatorInput;
+    std::vector<float> phaseOutput;
+    std::vector<float> blockTruePeak;
+    
+    //the audio delay, plus the same delay for the detected peaks so the meter lines up with the gain
+    juce::AudioBuffer<float> delayLine;
+    std::vector<float> peakDelayLine;
+    int delayPosition {0};
+    int peakDelayPosition {0};
+    
+    /**
+     minimum of the last 'windowLength' values, as a monotonic queue in a fixed ring
+     */
+    struct SlidingMinimum
+    {
+        void prepare(int windowLength);
+        void reset();
+        float push(float value);
+        
+    private:
+        std::vector<std::pair<std::int64_t, float>> queue;
+        int head {0}, size {0};
+        std::int64_t index {0};
+        int length {1};
+    };
+    SlidingMinimum requiredGainHold;
+    
+    float envelope {1.f};
+    std::vector<float> smoothingRing;
+    double smoothingSum {0.0};
+    int smoothingPosition {0};
+    
+    /**
+     clears the hold, envelope and smoothing so the limiter starts at unity gain. doesn't allocate.
+     */
+    void resetLimiter();
+    
+    void processChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    void detectTruePeaks(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    
+    std::atomic<float> maxTruePeak {0.f};
+    std::atomic<bool> peakResetRequested {false};
+    std::atomic<float> gainReductionDb {0.f};
+};
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    AnalyzerDecimator.h
+    Created: 19 Oct 2026 11:47:05am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ low-passes and downsamples the analyzer's mono signal so a long FFT can be run on the lows.
+ only the bottom half of the decimated spectrum is meant to be used: the anti-alias filter keeps
+ that half flat and rejects everything that would fold back onto it.
+ */
+struct AnalyzerDecimator
+{
+    void prepare(int factor)
+    {
+        decimationFactor = factor;
+        phase = 0;
+        
+        //designed at a normalised sample rate of 1, so it's the same at every host rate.
+        //the transition is centred on 0.5 / factor and 0.4 / factor wide, so the pass band ends at
+        //0.3 / factor and the stop band starts at 0.7 / factor, below the 0.75 / factor that folds
+        //back onto the bottom half.
+        auto coefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderEllipticMethod(0.5f / factor,
+                                                                                                   1.0,
+                                                                                                   0.4f / factor,
+                                                                                                   -0.05f,
+                                                                                                   -90.f);
+        filters.clear();
+        for( auto* c : coefficients )
+        {
+            filters.emplace_back(c);
+            filters.back().reset();
+        }
+    }
+    
+    int getNumOutputSamples(int numInputSamples) const
+    {
+        return (phase + numInputSamples) / decimationFactor;
+    }
+    
+    /**
+     writes getNumOutputSamples(numInputSamples) samples to 'output'
+     */
+    void process(const float* input, int numInputSamples, float* output)
+    {
+        for( int i = 0; i < numInputSamples; ++i )
+        {
+            auto y = input[i];
+            for( auto& filter : filters )
+            {
+                y = filter.processSample(y);
+            }
+            
+            if( ++phase == decimationFactor )
+            {
+                phase = 0;
+                *output++ = y;
+            }
+        }
+    }
+    
+private:
+    int decimationFactor {1};
+    int phase {0};
+    std::vector<juce::dsp::IIR::Filter<float>> filters;
+};
@@ -29,9 +29,13 @@ struct AnalyzerPathGenerator
         auto width = fftBounds.getWidth();
 
         int numBins = (int)fftSize / 2;
+        
+        updateColumns(numBins, binWidth, width);
 
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        //the same path is rebuilt every frame, so once it has grown to fit it never reallocates
+        auto& p = workingPath;
+        p.clear();
+        p.preallocateSpace(3 * (2 * (int)columns.size() + 1));
 
         auto map = [bottom, top, negativeInfinity](float v)
         {
@@ -49,36 +53,99 @@ struct AnalyzerPathGenerator
         
         p.startNewSubPath(0, y);
 
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
-
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
+        //renderData comes out of FFTDataGenerator already sanitized, so no per-bin nan/inf checks here.
+        for( const auto& column : columns )
         {
-            y = map(renderData[binNum]);
-
-//            jassert( !std::isnan(y) && !std::isinf(y) );
-
-            if( !std::isnan(y) && !std::isinf(y) )
+            auto numBinsInColumn = column.endBin - column.startBin;
+            
+            if( numBinsInColumn == 1 )
+            {
+                p.lineTo(column.x, map(renderData[column.startBin]));
+            }
+            else
             {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
+                //many bins land on this pixel, keep the peak and the trough so nothing gets lost
+                auto range = juce::FloatVectorOperations::findMinAndMax(renderData.data() + column.startBin,
+                                                                       numBinsInColumn);
+                p.lineTo(column.x, map(range.getEnd()));
+                p.lineTo(column.x, map(range.getStart()));
             }
         }
 
-        pathFifo.push(p);
+        hasNewPath = true;
     }
 
     int getNumPathsAvailable() const
     {
-        return pathFifo.getNumAvailableForReading();
+        return hasNewPath ? 1 : 0;
     }
 
+    /**
+     swaps the newest path into 'path'. the caller's old path becomes the storage the next one is built in.
+     */
     bool getPath(PathType& path)
     {
-        return pathFifo.pull(path);
+        if( !hasNewPath )
+            return false;
+        
+        path.swapWithPath(workingPath);
+        hasNewPath = false;
+        return true;
     }
 private:
-    Fifo<PathType> pathFifo;
+    PathType workingPath;
+    bool hasNewPath {false};
+    
+    /**
+     a run of consecutive bins that all map to the same pixel column
+     */
+    struct Column
+    {
+        float x;
+        int startBin;
+        int endBin;
+    };
+    
+    std::vector<Column> columns;
+    
+    int columnsNumBins {0};
+    float columnsBinWidth {0.f};
+    float columnsWidth {0.f};
+    
+    /**
+     bin -> x only depends on the FFT size, the sample rate and the width,
+     so the log mapping is done once per change instead of once per bin per frame.
+     */
+    void updateColumns(int numBins, float binWidth, float width)
+    {
+        if( numBins == columnsNumBins && binWidth == columnsBinWidth && width == columnsWidth )
+            return;
+        
+        columnsNumBins = numBins;
+        columnsBinWidth = binWidth;
+        columnsWidth = width;
+        
+        columns.clear();
+        columns.reserve(juce::jmin(numBins, (int)width + 1));
+        
+        for( int binNum = 1; binNum < numBins; ++binNum )
+        {
+            auto binFreq = binNum * binWidth;
+            auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
+            int binX = std::floor(normalizedBinX * width);
+            
+            if( !columns.empty() && columns.back().x == binX )
+            {
+                columns.back().endBin = binNum + 1;
+                continue;
+            }
+            
+            //everything past the right edge is clipped away, one column is enough to reach it
+            if( !columns.empty() && columns.back().x > width )
+                break;
+            
+            columns.push_back({ float(binX), binNum, binNum + 1 });
+        }
+    }
 };
 
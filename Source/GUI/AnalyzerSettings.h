@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    AnalyzerSettings.h
+    Created: 21 Oct 2026 4:48:12pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ the analyzer's display settings. they only change what the editor draws, so they aren't host
+ parameters: they're properties of the processor's editorState tree, saved with the session but
+ not automatable and not part of presets or snapshots. each one is stored as a choice index.
+ */
+namespace AnalyzerSettings
+{
+enum Setting
+{
+    Resolution,
+    Response,
+    Smoothing,
+    
+    NumSettings
+};
+
+//choice index 0 is FFTOrder::order2048, the last one is multi-resolution
+inline constexpr std::array<const char*, 4> resolutionNames { "2048", "4096", "8192", "Multi-Res" };
+
+//in SpectrumSmoother::Response order
+inline constexpr std::array<const char*, 3> responseNames { "Raw", "Average", "Peak Hold" };
+
+inline constexpr std::array<const char*, 5> smoothingNames { "Off", "1/3 Oct", "1/6 Oct", "1/12 Oct", "1/24 Oct" };
+
+struct Spec
+{
+    const char* id;
+    const char* const* choices;
+    int numChoices;
+};
+
+inline constexpr std::array<Spec, NumSettings> specs
+{{
+    { "analyzerResolution", resolutionNames.data(), (int)resolutionNames.size() },
+    { "analyzerResponse", responseNames.data(), (int)responseNames.size() },
+    { "analyzerSmoothing", smoothingNames.data(), (int)smoothingNames.size() },
+}};
+
+inline juce::StringArray getChoices(Setting setting)
+{
+    const auto& spec = specs[(size_t)setting];
+    return juce::StringArray(spec.choices, spec.numChoices);
+}
+
+/**
+ the setting's choice index. a setting that was never set, or is out of range, is choice 0.
+ */
+inline int get(const juce::ValueTree& editorState, Setting setting)
+{
+    const auto& spec = specs[(size_t)setting];
+    return juce::jlimit(0, spec.numChoices - 1, (int)editorState.getProperty(spec.id, 0));
+}
+
+inline void set(juce::ValueTree editorState, Setting setting, int index)
+{
+    editorState.setProperty(specs[(size_t)setting].id, index, nullptr);
+}
+
+/**
+ true if 'property' is one of the analyzer settings
+ */
+inline bool isSetting(const juce::Identifier& property)
+{
+    for( const auto& spec : specs )
+    {
+        if( property == juce::Identifier(spec.id) )
+            return true;
+    }
+    
+    return false;
+}
+}
@@ -19,14 +19,6 @@ releaseSlider(nullptr, "ms", "RELEASE"),
 thresholdSlider(nullptr, "dB", "THRESH"),
 ratioSlider(nullptr, "")
 {
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    auto getParamHelper = [&params, &apvts = this -> apvts](const auto& name) -> auto&
-    {
-        return getParam(apvts, params, name);
-    };
-    
     addAndMakeVisible(attackSlider);
     addAndMakeVisible(releaseSlider);
     addAndMakeVisible(thresholdSlider);
@@ -143,6 +135,17 @@ void CompressorBandControls::buttonClicked(juce::Button *button)
     updateSoloMuteBypassToggleStates(*button);
 }
 
+void CompressorBandControls::setMorphEngaged(bool engaged)
+{
+    //bypass, mute and solo aren't morphed, so their buttons stay as they are
+    auto alpha = engaged ? 0.4f : 1.f;
+    
+    attackSlider.setAlpha(alpha);
+    releaseSlider.setAlpha(alpha);
+    thresholdSlider.setAlpha(alpha);
+    ratioSlider.setAlpha(alpha);
+}
+
 void CompressorBandControls::updateSliderEnablements()
 {
     auto disabled = muteButton.getToggleState() || bypassButton.getToggleState();
@@ -193,55 +196,19 @@ void CompressorBandControls::updateAttachments()
     }();
     
     using namespace Params;
-    std::vector<Names> names;
     
-    switch (bandType)
+    //in Pos order, for whichever band is selected
+    const auto band = static_cast<int>(bandType);
+    const std::array<Names, 7> names
     {
-                    
-        case Low:
-        {
-            names = std::vector<Names>
-            {
-                Names::Attack_Low_Band,
-                Names::Release_Low_Band,
-                Names::Threshold_Low_Band,
-                Names::Ratio_Low_Band,
-                Names::Mute_Low_Band,
-                Names::Solo_Low_Band,
-                Names::Bypassed_Low_Band
-            };
-            break;
-        }
-        case Mid:
-        {
-            names = std::vector<Names>
-            {
-                Names::Attack_Mid_Band,
-                Names::Release_Mid_Band,
-                Names::Threshold_Mid_Band,
-                Names::Ratio_Mid_Band,
-                Names::Mute_Mid_Band,
-                Names::Solo_Mid_Band,
-                Names::Bypassed_Mid_Band
-            };
-            break;
-        }
-        case High:
-        {
-            names = std::vector<Names>
-            {
-                Names::Attack_High_Band,
-                Names::Release_High_Band,
-                Names::Threshold_High_Band,
-                Names::Ratio_High_Band,
-                Names::Mute_High_Band,
-                Names::Solo_High_Band,
-                Names::Bypassed_High_Band
-            };
-            
-            break;
-        }
-    }
+        forBand(Names::Attack_Low_Band, band),
+        forBand(Names::Release_Low_Band, band),
+        forBand(Names::Threshold_Low_Band, band),
+        forBand(Names::Ratio_Low_Band, band),
+        forBand(Names::Mute_Low_Band, band),
+        forBand(Names::Solo_Low_Band, band),
+        forBand(Names::Bypassed_Low_Band, band)
+    };
     
     enum Pos
     {
@@ -254,11 +221,9 @@ void CompressorBandControls::updateAttachments()
         Bypass
     };
     
-    const auto& params = GetParams();
-    
-    auto getParamHelper = [&params, &apvts = this -> apvts, &names](const auto& pos) -> auto&
+    auto getParamHelper = [&apvts = this -> apvts, &names](const auto& pos) -> auto&
     {
-        return getParam(apvts, params, names.at(pos));
+        return getParam(apvts, names[pos]);
     };
     
     attackSliderAttachment.reset();
@@ -281,20 +246,21 @@ void CompressorBandControls::updateAttachments()
     addLabelPairs(thresholdSlider.labels, threshParam, "ms");
     thresholdSlider.changeParam(&threshParam);
     
-    auto& ratioParamRap = getParamHelper(Pos::Ratio);
+    //bind checks parameterTable has it as a choice
+    juce::AudioParameterChoice* ratioParam = nullptr;
+    bind(ratioParam, apvts.processor, names[Pos::Ratio]);
     
     ratioSlider.labels.clear();
     ratioSlider.labels.add({0.f, "1:1"});
-    auto ratioParam = dynamic_cast<juce::AudioParameterChoice*>(&ratioParamRap);
     ratioSlider.labels.add({1.0f,
         juce::String(ratioParam->choices.getReference(ratioParam->choices.size() -1).getIntValue()) + ":1"});
     ratioSlider.changeParam(ratioParam);
     
-    auto MakeAttachmentHelper = [&params, &apvts = this->apvts](auto& attachment,
-                                                  const auto& name,
-                                                  auto& slider)
+    auto MakeAttachmentHelper = [&apvts = this->apvts](auto& attachment,
+                                                       const auto& name,
+                                                       auto& slider)
     {
-        makeAttachment(attachment, apvts, params, name, slider);
+        makeAttachment(attachment, apvts, name, slider);
     };
     
     MakeAttachmentHelper(attackSliderAttachment, names[Pos::Attack], attackSlider);
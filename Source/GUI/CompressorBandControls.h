@@ -21,6 +21,11 @@ struct CompressorBandControls : juce::Component, juce::Button::Listener
     void paint (juce::Graphics& g) override;
     
     void buttonClicked(juce::Button* button) override;
+    
+    /**
+     dims the knobs the morph overrides while it's engaged
+     */
+    void setMorphEngaged(bool engaged);
 private:
     juce::AudioProcessorValueTreeState& apvts;
     
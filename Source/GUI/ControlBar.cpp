@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    ControlBar.cpp
+    Created: 19 Oct 2026 10:12:41am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "ControlBar.h"
+#include "../DSP/Params.h"
+#include "Utilities.h"
+#include "AnalyzerSettings.h"
+
+ControlBar::ControlBar(MultibandCompressorAudioProcessor& p) :
+editorState(p.editorState),
+loudnessMeter(p.loudnessMeter),
+truePeakLimiter(p.truePeakLimiter),
+dspLoad(p.dspLoad)
+{
+    auto& apvts = p.apvts;
+
+    using namespace Params;
+    
+    std::array<const char*, 3> labelTexts { "FFT", "RESP", "SMOOTH" };
+    
+    for( int i = 0; i < AnalyzerSettings::NumSettings; ++i )
+    {
+        auto setting = AnalyzerSettings::Setting(i);
+        auto& box = analyzerBoxes[(size_t)i];
+        auto& label = analyzerLabels[(size_t)i];
+        
+        box.addItemList(AnalyzerSettings::getChoices(setting), 1);
+        box.setSelectedItemIndex(AnalyzerSettings::get(editorState, setting), juce::dontSendNotification);
+        box.onChange = [this, setting, &box]()
+        {
+            AnalyzerSettings::set(editorState, setting, box.getSelectedItemIndex());
+        };
+        
+        label.setText(labelTexts[(size_t)i], juce::dontSendNotification);
+        label.setFont(12.f);
+        label.setColour(juce::Label::textColourId, juce::Colours::blueviolet);
+        label.attachToComponent(&box, true);
+        
+        addAndMakeVisible(box);
+    }
+    
+    editorState.addListener(this);
+    
+    truePeakLimiterButton.setButtonText("TP LIM");
+    makeAttachment(truePeakLimiterAttachment, apvts, Names::True_Peak_Limiter, truePeakLimiterButton);
+    addAndMakeVisible(truePeakLimiterButton);
+}
+
+ControlBar::~ControlBar()
+{
+    editorState.removeListener(this);
+}
+
+void ControlBar::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
+{
+    //a loaded session changes the settings under the boxes
+    for( int i = 0; i < AnalyzerSettings::NumSettings; ++i )
+    {
+        auto index = AnalyzerSettings::get(editorState, AnalyzerSettings::Setting(i));
+        analyzerBoxes[(size_t)i].setSelectedItemIndex(index, juce::dontSendNotification);
+    }
+}
+
+void ControlBar::paint(juce::Graphics &g)
+{
+    auto bounds = getLocalBounds();
+    drawModuleBackground(g, bounds);
+    
+    using namespace juce;
+    
+    auto formatLufs = [](float lufs)
+    {
+        return lufs < LoudnessMeter::minimumLufs ? String("-inf") : String(lufs, 1);
+    };
+    
+    std::array<String, 6> readouts
+    {
+        "M " + formatLufs(displayedMeters[0]),
+        "S " + formatLufs(displayedMeters[1]),
+        "I " + formatLufs(displayedMeters[2]),
+        "LRA " + String(displayedMeters[3], 1),
+        "TP " + formatLufs(displayedMeters[4]),
+        "GR " + String(displayedMeters[5], 1)
+    };
+    
+    g.setFont(10.f);
+    g.setColour(Colours::lightgrey);
+    
+    //loudness on the top row, range, true peak and limiting underneath
+    auto area = loudnessArea;
+    auto rowHeight = area.getHeight() / 2;
+    auto fieldWidth = area.getWidth() / 3;
+    
+    for( size_t i = 0; i < readouts.size(); ++i )
+    {
+        auto field = Rectangle<int>(area.getX() + fieldWidth * int(i % 3),
+                                    area.getY() + rowHeight * int(i / 3),
+                                    fieldWidth,
+                                    rowHeight);
+        g.drawFittedText(readouts[i], field, Justification::centredLeft, 1);
+    }
+    
+    //load and held peak on the top row, late blocks underneath in red once there are any
+    auto dspArea = dspLoadArea;
+    auto loadField = dspArea.removeFromTop(rowHeight);
+    auto peakField = loadField.removeFromRight(loadField.getWidth() / 2);
+    auto lateField = dspArea.withHeight(rowHeight);
+    
+    g.setColour(displayedLoad >= 100 ? Colours::red : Colours::lightgrey);
+    g.drawFittedText("DSP " + String(displayedLoad) + "%", loadField, Justification::centredLeft, 1);
+    
+    g.setColour(displayedPeakLoad >= 100 ? Colours::red : Colours::lightgrey);
+    g.drawFittedText("PK " + String(displayedPeakLoad) + "%", peakField, Justification::centredLeft, 1);
+    
+    g.setColour(displayedMissedDeadlines > 0 ? Colours::red : Colours::lightgrey);
+    g.drawFittedText("LATE " + String(displayedMissedDeadlines), lateField, Justification::centredLeft, 1);
+}
+
+void ControlBar::resized()
+{
+    auto bounds = getLocalBounds().reduced(6);
+    
+    //each box leaves room on its left for the attached label
+    auto layoutBox = [&bounds](juce::ComboBox& box, int labelWidth, int boxWidth)
+    {
+        bounds.removeFromLeft(labelWidth);
+        box.setBounds(bounds.removeFromLeft(boxWidth));
+    };
+    
+    layoutBox(analyzerBoxes[AnalyzerSettings::Resolution], 26, 58);
+    layoutBox(analyzerBoxes[AnalyzerSettings::Response], 36, 66);
+    layoutBox(analyzerBoxes[AnalyzerSettings::Smoothing], 50, 58);
+    
+    bounds.removeFromLeft(6);
+    truePeakLimiterButton.setBounds(bounds.removeFromLeft(54));
+    
+    dspLoadArea = bounds.removeFromRight(96);
+    bounds.removeFromRight(6);
+    
+    bounds.removeFromLeft(6);
+    loudnessArea = bounds;
+}
+
+void ControlBar::mouseUp(const juce::MouseEvent &e)
+{
+    //clicking the readout starts a new integrated measurement and clears the held true peak
+    if( loudnessArea.contains(e.getPosition()) )
+    {
+        loudnessMeter.reset();
+        truePeakLimiter.resetPeak();
+    }
+}
+
+bool ControlBar::update()
+{
+    std::array<float, 6> latest
+    {
+        loudnessMeter.getMomentaryLufs(),
+        loudnessMeter.getShortTermLufs(),
+        loudnessMeter.getIntegratedLufs(),
+        loudnessMeter.getLoudnessRange(),
+        truePeakLimiter.getMaxTruePeakDb(),
+        truePeakLimiter.getGainReductionDb()
+    };
+    
+    auto changed = false;
+    for( size_t i = 0; i < latest.size(); ++i )
+    {
+        //only a change in the shown digit needs a repaint
+        auto rounded = std::round(latest[i] * 10.f) / 10.f;
+        if( rounded != displayedMeters[i] )
+        {
+            displayedMeters[i] = rounded;
+            changed = true;
+        }
+    }
+    
+    if( changed )
+        repaint(loudnessArea);
+    
+    auto now = juce::Time::getMillisecondCounter();
+    auto peak = dspLoad.getAndResetPeakLoad();
+    if( peak >= heldPeakLoad || now - peakHeldSince > peakHoldMs )
+    {
+        heldPeakLoad = peak;
+        peakHeldSince = now;
+    }
+    
+    auto load = juce::roundToInt(dspLoad.getLoad() * 100.f);
+    auto peakLoad = juce::roundToInt(heldPeakLoad * 100.f);
+    auto missedDeadlines = dspLoad.getNumMissedDeadlines();
+    
+    if( load != displayedLoad || peakLoad != displayedPeakLoad || missedDeadlines != displayedMissedDeadlines )
+    {
+        displayedLoad = load;
+        displayedPeakLoad = peakLoad;
+        displayedMissedDeadlines = missedDeadlines;
+        
+        repaint(dspLoadArea);
+        changed = true;
+    }
+    
+    return changed;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ControlBar.h
+    Created: 19 Oct 2026 10:12:41am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+
+struct ControlBar : juce::Component, juce::ValueTree::Listener
+{
+    ControlBar(MultibandCompressorAudioProcessor& p);
+    ~ControlBar() override;
+    
+    void paint (juce::Graphics& g) override;
+    void resized() override;
+    void mouseUp(const juce::MouseEvent& e) override;
+    
+    /**
+     reads the latest loudness, true-peak and DSP load values, repainting the readouts if any of
+     them changed. returns true if it did.
+     */
+    bool update();
+    
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    
+private:
+    //in AnalyzerSettings::Setting order
+    std::array<juce::ComboBox, 3> analyzerBoxes;
+    std::array<juce::Label, 3> analyzerLabels;
+    
+    //the processor's editorState, which the analyzer boxes set and follow
+    juce::ValueTree editorState;
+    
+    juce::ToggleButton truePeakLimiterButton;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> truePeakLimiterAttachment;
+    
+    LoudnessMeter& loudnessMeter;
+    TruePeakLimiter& truePeakLimiter;
+    DSPLoadMeter& dspLoad;
+    
+    //momentary, short-term, integrated, range, true peak, limiter gain reduction. rounded to what's displayed
+    std::array<float, 6> displayedMeters {};
+    juce::Rectangle<int> loudnessArea;
+    
+    //load and its peak in whole percent, and the number of late blocks
+    int displayedLoad {0}, displayedPeakLoad {0}, displayedMissedDeadlines {0};
+    
+    //the peak holds for a few seconds so a single spike can be read
+    static constexpr juce::uint32 peakHoldMs = 3000;
+    float heldPeakLoad {0.f};
+    juce::uint32 peakHeldSince {0};
+    
+    juce::Rectangle<int> dspLoadArea;
+};
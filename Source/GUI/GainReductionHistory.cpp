@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    GainReductionHistory.cpp
+    Created: 19 Oct 2026 3:05:18pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "GainReductionHistory.h"
+#include "Utilities.h"
+
+namespace
+{
+const std::array<juce::Colour, 3> bandColours
+{
+    juce::Colours::hotpink,
+    juce::Colours::orange,
+    juce::Colour(215u, 201u, 134u)
+};
+}
+
+GainReductionHistory::GainReductionHistory(MultibandCompressorAudioProcessor& p) :
+audioProcessor(p)
+{
+    currentColumn.reset();
+}
+
+void GainReductionHistory::paint(juce::Graphics &g)
+{
+    MULTIBAND_TRACE_SCOPE("GainReductionHistory::paint");
+    using namespace juce;
+    
+    auto bounds = getLocalBounds();
+    drawModuleBackground(g, bounds);
+    
+    if( historyImage.isValid() )
+        g.drawImageAt(historyImage, plotArea.getX(), plotArea.getY());
+    
+    g.setColour(Colours::lightgrey);
+    g.setFont(10.f);
+    
+    auto labelArea = plotArea.reduced(3, 1);
+    auto seconds = historyLengthsSeconds[historyLengthIndex];
+    g.drawFittedText("GR " + String(seconds) + " s", labelArea, Justification::topLeft, 1);
+    g.drawFittedText("-" + String(maxGainReductionDb, 0) + " dB", labelArea, Justification::topRight, 1);
+}
+
+void GainReductionHistory::resized()
+{
+    plotArea = getLocalBounds().reduced(4);
+    
+    if( plotArea.isEmpty() )
+        return;
+    
+    completedColumns.reserve((size_t)plotArea.getWidth());
+    resetHistory();
+}
+
+void GainReductionHistory::mouseUp(const juce::MouseEvent &)
+{
+    historyLengthIndex = (historyLengthIndex + 1) % historyLengthsSeconds.size();
+    resetHistory();
+}
+
+void GainReductionHistory::resetHistory()
+{
+    if( plotArea.isEmpty() )
+        return;
+    
+    historyImage = juce::Image(juce::Image::ARGB, plotArea.getWidth(), plotArea.getHeight(), true);
+    
+    currentColumn.reset();
+    samplesInColumn = 0.0;
+    columnSampleRate = 0.0;
+    
+    repaint();
+}
+
+void GainReductionHistory::drawColumn(juce::Image::BitmapData& pixels, const Column& column, int x)
+{
+    using namespace juce;
+    
+    //one pixel wide, so it's written directly rather than through a Graphics context
+    for( int y = 0; y < pixels.height; ++y )
+        pixels.setPixelColour(x, y, Colours::transparentBlack);
+    
+    //each band gets its own lane, 0 dB at the top of the lane
+    auto laneHeight = pixels.height / (int)numBands;
+    
+    for( size_t band = 0; band < numBands; ++band )
+    {
+        auto laneTop = (int)band * laneHeight;
+        auto mapY = [laneTop, laneHeight](float db)
+        {
+            return laneTop + roundToInt((laneHeight - 1) * jlimit(0.f, 1.f, -db / maxGainReductionDb));
+        };
+        
+        auto top = mapY(column.shallowestDb[band]);
+        auto bottom = mapY(column.deepestDb[band]);
+        auto colour = bandColours[band];
+        
+        for( int y = top; y <= bottom; ++y )
+            pixels.setPixelColour(x, y, colour);
+    }
+}
+
+bool GainReductionHistory::update()
+{
+    MULTIBAND_TRACE_SCOPE("GainReductionHistory::update");
+    auto& fifo = audioProcessor.gainReductionHistoryFifo;
+    GainReductionHistoryBlock block;
+    
+    //whatever piled up while no editor was open is stale
+    if( !hasDrainedStaleBlocks )
+    {
+        while( fifo.pull(block) ) { }
+        hasDrainedStaleBlocks = true;
+        return false;
+    }
+    
+    auto sampleRate = audioProcessor.getSampleRate();
+    if( !historyImage.isValid() || sampleRate <= 0.0 )
+    {
+        while( fifo.pull(block) ) { }
+        return false;
+    }
+    
+    if( sampleRate != columnSampleRate )
+    {
+        columnSampleRate = sampleRate;
+        samplesPerColumn = historyLengthsSeconds[historyLengthIndex] * sampleRate / historyImage.getWidth();
+    }
+    
+    completedColumns.clear();
+    
+    auto addToColumn = [this](const GainReductionHistoryBlock& incoming)
+    {
+        for( size_t band = 0; band < numBands; ++band )
+        {
+            auto& deepest = currentColumn.deepestDb[band];
+            auto& shallowest = currentColumn.shallowestDb[band];
+            deepest = juce::jmin(deepest, incoming.deepestDb[band]);
+            shallowest = juce::jmax(shallowest, incoming.shallowestDb[band]);
+        }
+    };
+    
+    while( fifo.pull(block) )
+    {
+        addToColumn(block);
+        samplesInColumn += block.numSamples;
+        
+        //a long block can finish several columns, they all show that block
+        if( samplesInColumn < samplesPerColumn )
+            continue;
+        
+        while( samplesInColumn >= samplesPerColumn )
+        {
+            samplesInColumn -= samplesPerColumn;
+            
+            //a frame can't scroll by more than the whole image
+            if( (int)completedColumns.size() < historyImage.getWidth() )
+                completedColumns.push_back(currentColumn);
+        }
+        
+        //whatever is left of the block starts the next column
+        currentColumn.reset();
+        if( samplesInColumn > 0.0 )
+            addToColumn(block);
+    }
+    
+    if( completedColumns.empty() )
+        return false;
+    
+    //scroll what's already there left in one go, then draw only the new columns at the right edge
+    auto width = historyImage.getWidth();
+    auto numNew = (int)completedColumns.size();
+    
+    if( numNew < width )
+        historyImage.moveImageSection(0, 0, numNew, 0, width - numNew, historyImage.getHeight());
+    
+    juce::Image::BitmapData pixels(historyImage, juce::Image::BitmapData::writeOnly);
+    for( int i = 0; i < numNew; ++i )
+        drawColumn(pixels, completedColumns[(size_t)i], width - numNew + i);
+    
+    repaint(plotArea);
+    return true;
+}
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    GainReductionHistory.h
+    Created: 19 Oct 2026 3:05:18pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/**
+ scrolling view of each band's gain reduction over the last few seconds.
+ 
+ the processor pushes the deepest and shallowest gain reduction of every block, update() folds
+ those into pixel columns and only draws the new columns, after scrolling the existing ones left.
+ clicking cycles through the available history lengths.
+ */
+struct GainReductionHistory : juce::Component
+{
+    GainReductionHistory(MultibandCompressorAudioProcessor& p);
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseUp(const juce::MouseEvent& e) override;
+    
+    /**
+     pulls the blocks the processor has pushed since the last call and scrolls in any completed
+     columns. returns true if the display changed.
+     */
+    bool update();
+    
+private:
+    MultibandCompressorAudioProcessor& audioProcessor;
+    
+    static constexpr std::array<int, 4> historyLengthsSeconds { 5, 10, 20, 30 };
+    size_t historyLengthIndex {1};
+    
+    static constexpr float maxGainReductionDb = 24.f;
+    static constexpr size_t numBands = 3;
+    
+    juce::Rectangle<int> plotArea;
+    juce::Image historyImage;
+    
+    /**
+     the column being accumulated. blocks keep widening it until it covers 'samplesPerColumn'
+     */
+    struct Column
+    {
+        std::array<float, numBands> deepestDb;
+        std::array<float, numBands> shallowestDb;
+        
+        void reset()
+        {
+            deepestDb.fill(0.f);
+            shallowestDb.fill(std::numeric_limits<float>::lowest());
+        }
+    };
+    
+    Column currentColumn;
+    double samplesInColumn {0.0};
+    double samplesPerColumn {0.0};
+    double columnSampleRate {0.0};
+    
+    //columns completed during one update(), drawn after a single scroll. sized to the plot width.
+    std::vector<Column> completedColumns;
+    
+    bool hasDrainedStaleBlocks {false};
+    
+    void resetHistory();
+    static void drawColumn(juce::Image::BitmapData& pixels, const Column& column, int x);
+};
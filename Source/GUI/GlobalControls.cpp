@@ -15,17 +15,18 @@
 GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
 {
     using namespace Params;
-    const auto& params = GetParams();
     
-    auto getParamHelper = [&params, &apvts](const auto& name) -> auto&
+    auto getParamHelper = [&apvts](const auto& name) -> auto&
     {
-        return getParam(apvts, params, name);
+        return getParam(apvts, name);
     };
     
     auto& gainInParam = getParamHelper(Names::Gain_in);
     auto& lowMidParam = getParamHelper(Names::Low_Mid_Crossover_Freq);
     auto& midHighParam = getParamHelper(Names::Mid_High_Crossover_Freq);
     auto& GainOutParam = getParamHelper(Names::Gain_out);
+    auto& ceilingParam = getParamHelper(Names::True_Peak_Ceiling);
+    auto& morphParam = getParamHelper(Names::Morph);
 
     
     inGainSlider = std::make_unique<RSWL>(&gainInParam,
@@ -41,13 +42,19 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     outGainSlider = std::make_unique<RSWL>(&GainOutParam,
                                            "dB",
                                            "OUTPUT TRIM");
+    ceilingSlider = std::make_unique<RSWL>(&ceilingParam,
+                                           "dB",
+                                           "TP CEILING");
+    morphSlider = std::make_unique<RSWL>(&morphParam,
+                                         "%",
+                                         "A/B MORPH");
     
     
-    auto MakeAttachmentHelper = [&params, &apvts](auto& attachment,
-                                                  const auto& name,
-                                                  auto& slider)
+    auto MakeAttachmentHelper = [&apvts](auto& attachment,
+                                         const auto& name,
+                                         auto& slider)
     {
-        makeAttachment(attachment, apvts, params, name, slider);
+        makeAttachment(attachment, apvts, name, slider);
     };
     
     MakeAttachmentHelper(inGainSliderAttachment,
@@ -66,6 +73,14 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
                          Names::Gain_out,
                          *outGainSlider);
     
+    MakeAttachmentHelper(ceilingSliderAttachment,
+                         Names::True_Peak_Ceiling,
+                         *ceilingSlider);
+    
+    MakeAttachmentHelper(morphSliderAttachment,
+                         Names::Morph,
+                         *morphSlider);
+    
     addLabelPairs(inGainSlider->labels,
                   gainInParam,
                   "dB");
@@ -82,11 +97,44 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
                   GainOutParam,
                   "dB");
     
+    addLabelPairs(ceilingSlider->labels,
+                  ceilingParam,
+                  "dB");
+    
+    //the ends of the morph are the snapshots
+    morphSlider->labels.clear();
+    morphSlider->labels.add({0.f, "A"});
+    morphSlider->labels.add({1.f, "B"});
+    
     
     addAndMakeVisible(*inGainSlider);
     addAndMakeVisible(*lowMidXoverSlider);
     addAndMakeVisible(*midHighXoverSlider);
     addAndMakeVisible(*outGainSlider);
+    addAndMakeVisible(*ceilingSlider);
+    addAndMakeVisible(*morphSlider);
+    
+    //store the current settings as a snapshot, the morph starts working once both are stored
+    auto setUpStoreButton = [this](juce::TextButton& button, int snapshot)
+    {
+        button.onClick = [this, snapshot]
+        {
+            if( onStoreSnapshot )
+                onStoreSnapshot(snapshot);
+        };
+        addAndMakeVisible(button);
+    };
+    
+    setUpStoreButton(storeAButton, 0);
+    setUpStoreButton(storeBButton, 1);
+    
+    //hands the knobs back
+    clearButton.onClick = [this]
+    {
+        if( onClearSnapshots )
+            onClearSnapshots();
+    };
+    addAndMakeVisible(clearButton);
 
     
 }
@@ -97,11 +145,36 @@ void GlobalControls::paint(juce::Graphics &g)
     drawModuleBackground(g, bounds);
 }
 
+void GlobalControls::setSnapshotStored(int snapshot, bool stored)
+{
+    auto& button = snapshot == 0 ? storeAButton : storeBButton;
+    button.setToggleState(stored, juce::dontSendNotification);
+    
+    clearButton.setEnabled(storeAButton.getToggleState() || storeBButton.getToggleState());
+}
+
+void GlobalControls::setMorphEngaged(bool engaged)
+{
+    //the knobs still move the parameters, it's just not what's heard until the snapshots are cleared
+    auto alpha = engaged ? 0.4f : 1.f;
+    
+    for( auto* slider : { inGainSlider.get(), lowMidXoverSlider.get(), midHighXoverSlider.get(), outGainSlider.get(), ceilingSlider.get() } )
+        slider->setAlpha(alpha);
+}
+
 void GlobalControls::resized()
 {
     auto bounds = getLocalBounds().reduced(5);
     using namespace juce;
     
+    //the store and clear buttons stack up on the right, next to the morph
+    auto buttonColumn = bounds.removeFromRight(30).withSizeKeepingCentre(24, 80);
+    storeAButton.setBounds(buttonColumn.removeFromTop(24));
+    buttonColumn.removeFromTop(4);
+    storeBButton.setBounds(buttonColumn.removeFromTop(24));
+    buttonColumn.removeFromTop(4);
+    clearButton.setBounds(buttonColumn);
+    
     FlexBox flexBox;
     flexBox.flexDirection = FlexBox::Direction::row;
     flexBox.flexWrap = FlexBox::Wrap::noWrap;
@@ -117,6 +190,10 @@ void GlobalControls::resized()
     flexBox.items.add(FlexItem(*midHighXoverSlider).withFlex(1.f));
     flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(*outGainSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*ceilingSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*morphSlider).withFlex(1.f));
     flexBox.items.add(endCap);
 
     
@@ -19,15 +19,39 @@ struct GlobalControls : juce::Component
     void paint (juce::Graphics& g) override;
     void resized() override;
     
+    /**
+     called with 0 for A or 1 for B when one of the store buttons is clicked
+     */
+    std::function<void(int snapshot)> onStoreSnapshot;
+    
+    /**
+     called when the clear button is clicked
+     */
+    std::function<void()> onClearSnapshots;
+    
+    /**
+     lights the store button of a snapshot that holds settings
+     */
+    void setSnapshotStored(int snapshot, bool stored);
+    
+    /**
+     dims the knobs the morph overrides while it's engaged
+     */
+    void setMorphEngaged(bool engaged);
+    
 private:
     using RSWL = RotarySliderWithLabels;
-    std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider;
+    std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider, ceilingSlider, morphSlider;
+    
+    juce::TextButton storeAButton {"A"}, storeBButton {"B"}, clearButton {"CLR"};
     
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<Attachment> lowMidXoverSliderAttachment,
                                 midHighXoverSliderAttachment,
                                 inGainSliderAttachment,
-                                outGainSliderAttachment;
+                                outGainSliderAttachment,
+                                ceilingSliderAttachment,
+                                morphSliderAttachment;
     
     
 };
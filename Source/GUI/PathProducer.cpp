@@ -10,52 +10,192 @@
 
 #include "PathProducer.h"
 
+namespace
+{
+/**
+ adds the ticks between construction and destruction to 'total', or does nothing when it's null
+ */
+struct ScopedStageTimer
+{
+    explicit ScopedStageTimer(juce::int64* totalToAddTo) :
+    total(totalToAddTo),
+    start(total != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+    {
+    }
+    
+    ~ScopedStageTimer()
+    {
+        if( total != nullptr )
+            *total += juce::Time::getHighResolutionTicks() - start;
+    }
+    
+    juce::int64* total;
+    juce::int64 start;
+};
+}
 
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+void PathProducer::changeResolution(FFTOrder newOrder, bool multiResolution)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
+    if( newOrder == requestedOrder && multiResolution == requestedMultiResolution )
+        return;
+    
+    requestedOrder = newOrder;
+    requestedMultiResolution = multiResolution;
+    
+    backgroundThread->pool.addJob([pending = pendingAnalysis, newOrder, multiResolution]()
+    {
+        auto ready = std::make_unique<Analysis>(newOrder, multiResolution);
+        
+        //if an older request hasn't been picked up yet, this one replaces it
+        delete pending->analysis.exchange(ready.release());
+    });
+}
+
+void PathProducer::shiftIn(juce::AudioBuffer<float>& buffer, const float* newSamples, int numNewSamples)
+{
+    auto size = numNewSamples;
+
+    jassert(size <= buffer.getNumSamples());
+    size = juce::jmin(size, buffer.getNumSamples());
+    
+    auto writePointer = buffer.getWritePointer(0, 0);
+    auto readPointer = buffer.getReadPointer(0, size);
+    
+    std::copy(readPointer,
+              readPointer + (buffer.getNumSamples() - size),
+              writePointer);
+    
+    juce::FloatVectorOperations::copy(buffer.getWritePointer(0, buffer.getNumSamples() - size),
+                                      newSamples + (numNewSamples - size),
+                                      size);
+}
+
+void PathProducer::Analysis::stitch()
+{
+    //below a quarter of the decimated rate the low FFT's bins line up 1:1 with the stitched ones.
+    //above that, the high FFT's bins are 'multiResolutionDecimation' stitched bins apart, so interpolate.
+    const auto numStitchedBins = (int)stitchedFFTData.size();
+    const auto splitBin = lowFFTDataGenerator.getFFTSize() / 4;
+    const auto numHighBins = fftDataGenerator.getFFTSize() / 2;
+    
+    std::copy(lowFFTData.begin(), lowFFTData.begin() + splitBin, stitchedFFTData.begin());
+    
+    constexpr auto step = 1.f / multiResolutionDecimation;
+    for( int bin = splitBin; bin < numStitchedBins; ++bin )
+    {
+        auto highBin = bin / multiResolutionDecimation;
+        auto frac = (bin % multiResolutionDecimation) * step;
+        auto next = juce::jmin(highBin + 1, numHighBins - 1);
+        stitchedFFTData[bin] = highFFTData[highBin] + frac * (highFFTData[next] - highFFTData[highBin]);
+    }
+}
+
+bool PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    MULTIBAND_TRACE_SCOPE("PathProducer::process");
+    
+    if( auto* ready = pendingAnalysis->analysis.exchange(nullptr) )
+    {
+        analysis.reset(ready);
+    }
+    
+    auto& monoBuffer = analysis->monoBuffer;
+    auto& leftChannelFFTDataGenerator = analysis->fftDataGenerator;
+    
+    auto* fifoTicks = stageTimes != nullptr ? &stageTimes->fifoTicks : nullptr;
+    auto* fftTicks = stageTimes != nullptr ? &stageTimes->fftTicks : nullptr;
+    auto* pathTicks = stageTimes != nullptr ? &stageTimes->pathTicks : nullptr;
+    
     while( leftChannelFifo->getNumCompleteBuffersAvailable() > 0 )
     {
-        if( leftChannelFifo->getAudioBuffer(tempIncomingBuffer) )
+        auto pulled = false;
         {
-            auto size = tempIncomingBuffer.getNumSamples();
-
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
-            
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
+            ScopedStageTimer timer(fifoTicks);
+            pulled = leftChannelFifo->getAudioBuffer(incomingBuffer);
             
-            std::copy(readPointer,
-                      readPointer + (monoBuffer.getNumSamples() - size),
-                      writePointer);
+            if( pulled )
+                shiftIn(monoBuffer, incomingBuffer.getReadPointer(0, 0), incomingBuffer.getNumSamples());
+        }
+        
+        if( pulled )
+        {
+            ScopedStageTimer timer(fftTicks);
             
-//            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-//                                              monoBuffer.getReadPointer(0, size),
-//                                              monoBuffer.getNumSamples() - size);
-
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                                              tempIncomingBuffer.getReadPointer(0, 0),
-                                              size);
+            auto size = incomingBuffer.getNumSamples();
+            frameSeconds = float(size / sampleRate);
             
             leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
+            
+            if( analysis->multiResolution )
+            {
+                //decimate straight into the end of the low buffer
+                auto& decimatedBuffer = analysis->decimatedBuffer;
+                auto numDecimated = analysis->decimator.getNumOutputSamples(size);
+                
+                jassert(numDecimated <= decimatedBuffer.getNumSamples());
+                if( numDecimated <= decimatedBuffer.getNumSamples() )
+                {
+                    auto numToKeep = decimatedBuffer.getNumSamples() - numDecimated;
+                    
+                    std::copy(decimatedBuffer.getReadPointer(0, numDecimated),
+                              decimatedBuffer.getReadPointer(0, numDecimated) + numToKeep,
+                              decimatedBuffer.getWritePointer(0, 0));
+                    
+                    analysis->decimator.process(incomingBuffer.getReadPointer(0, 0),
+                                                size,
+                                                decimatedBuffer.getWritePointer(0, numToKeep));
+                }
+                
+                analysis->lowFFTDataGenerator.produceFFTDataForRendering(decimatedBuffer, negativeInfinity);
+            }
         }
     }
     
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
+    const auto fftSize = analysis->getFFTSize();
     const auto binWidth = sampleRate / double(fftSize);
+    
+    //every block goes through the smoother so averaging and peak hold see all of them,
+    //but only the newest one gets turned into a path.
+    auto newFFTData = false;
+    const auto& spectrum = analysis->multiResolution ? analysis->stitchedFFTData : fftData;
 
-    while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
     {
-        std::vector<float> fftData;
-        if( leftChannelFFTDataGenerator.getFFTData( fftData) )
+        ScopedStageTimer timer(fftTicks);
+        
+        if( analysis->multiResolution )
+        {
+            auto& lowFFTDataGenerator = analysis->lowFFTDataGenerator;
+            
+            //both FFTs produce one block per incoming buffer, so they stay paired up
+            while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 &&
+                   lowFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
+            {
+                if( leftChannelFFTDataGenerator.getFFTData(analysis->highFFTData) &&
+                    lowFFTDataGenerator.getFFTData(analysis->lowFFTData) )
+                {
+                    analysis->stitch();
+                    smoother.process(analysis->stitchedFFTData.data(), fftSize / 2, frameSeconds);
+                    newFFTData = true;
+                }
+            }
+        }
+        else
         {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
+            while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
+            {
+                if( leftChannelFFTDataGenerator.getFFTData( fftData) )
+                {
+                    smoother.process(fftData.data(), fftSize / 2, frameSeconds);
+                    newFFTData = true;
+                }
+            }
         }
     }
     
-    while( pathProducer.getNumPathsAvailable() > 0 )
-    {
-        pathProducer.getPath( leftChannelFFTPath );
-    }
+    ScopedStageTimer timer(pathTicks);
+    
+    if( newFFTData )
+        pathProducer.generatePath(spectrum, fftBounds, fftSize, binWidth, negativeInfinity);
+    
+    return pathProducer.getPath( leftChannelFFTPath );
 }
@@ -12,31 +12,154 @@
 #include <JuceHeader.h>
 #include "FFTDataGenerator.h"
 #include "AnalyzerPathGenerator.h"
+#include "AnalyzerDecimator.h"
+#include "SpectrumSmoother.h"
 #include "../PluginProcessor.h"
 
 
 struct PathProducer
 {
     PathProducer(SingleChannelSampleFifo<MultibandCompressorAudioProcessor::BlockType>& scsf) :
-    leftChannelFifo(&scsf)
+    leftChannelFifo(&scsf),
+    analysis(std::make_unique<Analysis>(FFTOrder::order2048, false))
     {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
     }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+    /**
+     returns true if a new path was produced
+     */
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate);
+    const juce::Path& getPath() const { return leftChannelFFTPath; }
     
     void updateNegativeInfinity(float nf) {negativeInfinity = nf; }
+    
+    /**
+     builds the FFT, window and buffers for 'newOrder' on a background thread.
+     process() keeps using the current ones until the new set is ready, then swaps it in.
+     
+     with 'multiResolution' the FFT runs on the signal for the highs, and a second FFT of the
+     same order runs on the signal decimated by multiResolutionDecimation for the lows.
+     */
+    void changeResolution(FFTOrder newOrder, bool multiResolution);
+    
+    /**
+     the FFT process() is using now. it lags changeResolution() until the new one is built and swapped in.
+     */
+    FFTOrder getOrder() const { return analysis->order; }
+    bool isMultiResolution() const { return analysis->multiResolution; }
+    
+    /**
+     true once process() is using the FFT the last changeResolution() asked for
+     */
+    bool isResolutionReady() const { return getOrder() == requestedOrder && isMultiResolution() == requestedMultiResolution; }
+    
+    static constexpr int multiResolutionDecimation = 8;
+    
+    void setResponse(SpectrumSmoother::Response response) { smoother.setResponse(response); }
+    void setBandsPerOctave(int bandsPerOctave) { smoother.setBandsPerOctave(bandsPerOctave); }
+    
+    /**
+     high resolution ticks process() spent in each stage, added to on every call.
+     the FFT stage includes smoothing and stitching, the path stage is the path build and hand off.
+     */
+    struct StageTimes
+    {
+        juce::int64 fifoTicks {0};
+        juce::int64 fftTicks {0};
+        juce::int64 pathTicks {0};
+    };
+    
+    /**
+     process() adds its stage timings to 'times' until it's given nullptr. off by default.
+     */
+    void setStageTimes(StageTimes* times) { stageTimes = times; }
 private:
     SingleChannelSampleFifo<MultibandCompressorAudioProcessor::BlockType>* leftChannelFifo;
     
-    juce::AudioBuffer<float> monoBuffer;
+    /**
+     everything whose size depends on the FFT order
+     */
+    struct Analysis
+    {
+        Analysis(FFTOrder fftOrder, bool useMultiResolution) :
+        order(fftOrder),
+        multiResolution(useMultiResolution)
+        {
+            fftDataGenerator.changeOrder(order);
+            monoBuffer.setSize(1, fftDataGenerator.getFFTSize());
+            monoBuffer.clear();
+            
+            if( multiResolution )
+            {
+                lowFFTDataGenerator.changeOrder(order);
+                decimatedBuffer.setSize(1, lowFFTDataGenerator.getFFTSize());
+                decimatedBuffer.clear();
+                decimator.prepare(multiResolutionDecimation);
+                
+                highFFTData.resize(fftDataGenerator.getFFTSize() * 2, 0);
+                lowFFTData.resize(lowFFTDataGenerator.getFFTSize() * 2, 0);
+                stitchedFFTData.resize(getFFTSize() / 2, 0);
+            }
+        }
+        
+        /**
+         the size of the FFT the rendered spectrum is laid out for.
+         in multi-resolution mode that's the size the low FFT would have at the full sample rate.
+         */
+        int getFFTSize() const
+        {
+            return fftDataGenerator.getFFTSize() * (multiResolution ? multiResolutionDecimation : 1);
+        }
+        
+        const FFTOrder order;
+        const bool multiResolution;
+        
+        juce::AudioBuffer<float> monoBuffer;
+        FFTDataGenerator<std::vector<float>> fftDataGenerator;
+        
+        //multi-resolution only
+        AnalyzerDecimator decimator;
+        juce::AudioBuffer<float> decimatedBuffer;
+        FFTDataGenerator<std::vector<float>> lowFFTDataGenerator;
+        std::vector<float> highFFTData, lowFFTData, stitchedFFTData;
+        
+        void stitch();
+    };
     
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
+    /**
+     single slot handed from the background thread to the message thread.
+     it's shared with the background job so it outlives a PathProducer destroyed mid-build.
+     */
+    struct PendingAnalysis
+    {
+        ~PendingAnalysis() { delete analysis.exchange(nullptr); }
+        std::atomic<Analysis*> analysis {nullptr};
+    };
+    
+    struct BackgroundThread
+    {
+        juce::ThreadPool pool {1};
+    };
+    
+    std::unique_ptr<Analysis> analysis;
+    std::shared_ptr<PendingAnalysis> pendingAnalysis { std::make_shared<PendingAnalysis>() };
+    FFTOrder requestedOrder {FFTOrder::order2048};
+    bool requestedMultiResolution {false};
+    juce::SharedResourcePointer<BackgroundThread> backgroundThread;
+    
+    static void shiftIn(juce::AudioBuffer<float>& buffer, const float* newSamples, int numNewSamples);
+    
+    SpectrumSmoother smoother;
+    float frameSeconds {0.f};
+    
+    //reused every frame so process() doesn't allocate once they've grown to size
+    juce::AudioBuffer<float> incomingBuffer;
+    std::vector<float> fftData;
     
     AnalyzerPathGenerator<juce::Path> pathProducer;
     
     juce::Path leftChannelFFTPath;
     
     float negativeInfinity {-48.f};
+    
+    StageTimes* stageTimes {nullptr};
 };
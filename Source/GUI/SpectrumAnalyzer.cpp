@@ -11,6 +11,7 @@
 #include "SpectrumAnalyzer.h"
 #include "Utilities.h"
 #include "../DSP/Params.h"
+#include "AnalyzerSettings.h"
 
 SpectrumAnalyzer::SpectrumAnalyzer(MultibandCompressorAudioProcessor& p) :
 audioProcessor(p),
@@ -24,23 +25,18 @@ rightPathProducer(audioProcessor.rightChannelFifo)
     }
     
     using namespace Params;
-    const auto& paramNames = GetParams();
     
-    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
-        jassert(param !=nullptr);
-    };
+    lowMidXoverParam = &getParam<Names::Low_Mid_Crossover_Freq>(audioProcessor);
+    midHighXoverParam = &getParam<Names::Mid_High_Crossover_Freq>(audioProcessor);
     
-    floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
+    lowThresholdParam = &getParam<Names::Threshold_Low_Band>(audioProcessor);
+    midThresholdParam = &getParam<Names::Threshold_Mid_Band>(audioProcessor);
+    highThresholdParam = &getParam<Names::Threshold_High_Band>(audioProcessor);
     
-    floatHelper(lowThresholdParam, Names::Threshold_Low_Band);
-    floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
-    floatHelper(highThresholdParam, Names::Threshold_High_Band);
-
+    editorState = audioProcessor.editorState;
+    editorState.addListener(this);
     
-    startTimerHz(60);
+    updateAnalyzerSettings();
 }
 
 SpectrumAnalyzer::~SpectrumAnalyzer()
@@ -50,6 +46,8 @@ SpectrumAnalyzer::~SpectrumAnalyzer()
     {
         param->removeListener(this);
     }
+    
+    editorState.removeListener(this);
 }
 
 void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> bounds)
@@ -61,34 +59,38 @@ void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics &g, juce::Rectangle<int> b
     
     Graphics::ScopedSaveState sss(g);
     g.reduceClipRegion(responseArea);
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0
-                                                                     //responseArea.getY()
-                                                                    ));
+    //the paths are stroked in place, the transform moves them into the response area without copying
+    auto toResponseArea = AffineTransform::translation(float(responseArea.getX()), 0.f);
     
     g.setColour(Colour(97u, 18u, 167u)); //purple-
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-    
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0
-                                                                    // responseArea.getY()
-                                                                     ));
+    g.strokePath(leftPathProducer.getPath(), PathStrokeType(1.f), toResponseArea);
     
     g.setColour(Colour(215u, 201u, 134u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+    g.strokePath(rightPathProducer.getPath(), PathStrokeType(1.f), toResponseArea);
 }
 
 
 
 void SpectrumAnalyzer::paint (juce::Graphics& g)
 {
+    MULTIBAND_TRACE_SCOPE("SpectrumAnalyzer::paint");
     using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (Colours::black);
-
-    auto bounds = drawModuleBackground(g, getLocalBounds());
-    drawBackgroundGrid(g, bounds);
     
+    if( getLocalBounds().isEmpty() )
+        return;
+    
+    //the background, grid and labels only change on resize or scale change, so they're cached.
+    //only the analysis, crossovers and gain reduction are drawn every frame.
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if( backgroundLayer.isNull() || scale != layerScale )
+    {
+        updateLayers(scale);
+    }
+    
+    auto localBounds = getLocalBounds().toFloat();
+    g.drawImage(backgroundLayer, localBounds);
+    
+    auto bounds = moduleBounds;
     
     if( shouldShowFFTAnalysis )
     {
@@ -96,21 +98,39 @@ void SpectrumAnalyzer::paint (juce::Graphics& g)
 
     }
     
-//    Path border;
-//
-//    border.setUsingNonZeroWinding(false);
-//
-//    border.addRoundedRectangle(getRenderArea(bounds), 4);
-//    border.addRectangle(getLocalBounds());
-//
-//    g.setColour(Colours::black);
-    
-    //g.fillPath(border);
     drawCrossovers(g, bounds);
-    drawTextLabels(g, bounds);
     
-//    g.setColour(Colours::orange);
-//    g.drawRoundedRectangle(getRenderArea(bounds).toFloat(), 4.f, 1.f);
+    g.drawImage(labelLayer, localBounds);
+}
+
+void SpectrumAnalyzer::updateLayers(float scale)
+{
+    using namespace juce;
+    
+    layerScale = scale;
+    
+    auto width = jmax(1, roundToInt(getWidth() * scale));
+    auto height = jmax(1, roundToInt(getHeight() * scale));
+    
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    backgroundLayer = Image(Image::RGB, width, height, true);
+    {
+        Graphics g(backgroundLayer);
+        g.addTransform(AffineTransform::scale(scale));
+        g.fillAll (Colours::black);
+        
+        moduleBounds = drawModuleBackground(g, getLocalBounds());
+        drawBackgroundGrid(g, moduleBounds);
+    }
+    
+    //labels sit on top of the crossovers and gain reduction, so they get their own transparent layer
+    labelLayer = Image(Image::ARGB, width, height, true);
+    {
+        Graphics g(labelLayer);
+        g.addTransform(AffineTransform::scale(scale));
+        
+        drawTextLabels(g, moduleBounds);
+    }
 }
 void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bounds)
 {
@@ -148,23 +168,24 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bo
     };
     
     auto zeroDb = mapY(0.f);
-    g.setColour(Colours::hotpink.withAlpha(0.3f));
-    
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left,
-                                                    zeroDb,
-                                                    lowMidX,
-                                                    mapY(lowBandGR)));
-    
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX,
-                                                    zeroDb,
-                                                    midHighX,
-                                                    mapY(midBandGR)));
-    
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX,
-                                                    zeroDb,
-                                                    right,
-                                                    mapY(highBandGR)));
     
+    //the fill is the average gain reduction over the last block, the line marks the peak
+    std::array<float, 4> bandEdges { float(left), lowMidX, midHighX, float(right) };
+    for( size_t band = 0; band < bandGainReduction.size(); ++band )
+    {
+        auto bandLeft = bandEdges[band];
+        auto bandRight = bandEdges[band + 1];
+        const auto& gr = bandGainReduction[band];
+        
+        g.setColour(Colours::hotpink.withAlpha(0.3f));
+        g.fillRect(Rectangle<float>::leftTopRightBottom(bandLeft,
+                                                        zeroDb,
+                                                        bandRight,
+                                                        mapY(gr.averageDb)));
+        
+        g.setColour(Colours::hotpink);
+        g.drawHorizontalLine(roundToInt(mapY(gr.peakDb)), bandLeft, bandRight);
+    }
     
     g.setColour(Colours::yellow);
     
@@ -179,24 +200,58 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics &g, juce::Rectangle<int> bo
     
 }
 
-void SpectrumAnalyzer::update(const std::vector<float> &values)
+bool SpectrumAnalyzer::update(const std::array<GainReductionTelemetry::Reading, 3>& gainReduction)
 {
-    jassert(values.size() == 6);
+    MULTIBAND_TRACE_SCOPE("SpectrumAnalyzer::update");
     
-    enum
+    auto grChanged = false;
+    auto updateGR = [&grChanged](float& gr, float newGR)
     {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
+        //anything smaller than this doesn't move the overlay by a pixel
+        constexpr float minimumChangeDb = 0.05f;
+        if( std::abs(newGR - gr) > minimumChangeDb )
+        {
+            gr = newGR;
+            grChanged = true;
+        }
     };
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
     
-    repaint();
+    for( size_t band = 0; band < bandGainReduction.size(); ++band )
+    {
+        updateGR(bandGainReduction[band].peakDb, gainReduction[band].peakDb);
+        updateGR(bandGainReduction[band].averageDb, gainReduction[band].averageDb);
+    }
+    
+    auto newAnalysis = false;
+    if( shouldShowFFTAnalysis )
+    {
+        auto bounds = getLocalBounds();
+        auto fftBounds = getAnalysisArea(bounds).toFloat();
+        fftBounds.setBottom(bounds.getBottom());
+        auto sampleRate = audioProcessor.getSampleRate();
+        
+        newAnalysis |= leftPathProducer.process(fftBounds, sampleRate);
+        newAnalysis |= rightPathProducer.process(fftBounds, sampleRate);
+    }
+
+    auto paramsChanged = parametersChanged.compareAndSetBool(false, true);
+    if( paramsChanged )
+    {
+        updateAnalyzerSettings();
+    }
+    
+    auto enablementChanged = std::exchange(analysisEnablementChanged, false);
+    
+    if( !(grChanged || newAnalysis || paramsChanged || enablementChanged) )
+        return false;
+    
+    //everything that changes between frames is drawn inside the analysis area
+    if( moduleBounds.isEmpty() )
+        repaint();
+    else
+        repaint(getAnalysisArea(moduleBounds));
+    
+    return true;
 }
 
 std::vector<float> SpectrumAnalyzer::getFrequencies()
@@ -358,6 +413,8 @@ void SpectrumAnalyzer::drawTextLabels(juce::Graphics &g, juce::Rectangle<int> bo
 void SpectrumAnalyzer::resized()
 {
     using namespace juce;
+    backgroundLayer = Image();
+    
     auto bounds = getLocalBounds();
     auto fftBounds = getAnalysisArea(bounds).toFloat();
     auto negInf = jmap(bounds.toFloat().getBottom(),
@@ -370,31 +427,40 @@ void SpectrumAnalyzer::resized()
     rightPathProducer.updateNegativeInfinity(negInf);
 }
 
+void SpectrumAnalyzer::updateAnalyzerSettings()
+{
+    //the resolution choices start at order2048 and go up one order per index.
+    //the last choice is multi-resolution, which runs two order2048 FFTs.
+    constexpr int multiResolutionChoice = 3;
+    auto index = AnalyzerSettings::get(editorState, AnalyzerSettings::Resolution);
+    auto multiResolution = index == multiResolutionChoice;
+    auto order = multiResolution ? FFTOrder::order2048 : static_cast<FFTOrder>(FFTOrder::order2048 + index);
+    
+    leftPathProducer.changeResolution(order, multiResolution);
+    rightPathProducer.changeResolution(order, multiResolution);
+    
+    auto response = static_cast<SpectrumSmoother::Response>(AnalyzerSettings::get(editorState, AnalyzerSettings::Response));
+    
+    //smoothing choices are off, then 1/3, 1/6, 1/12 and 1/24 octave
+    auto smoothingIndex = AnalyzerSettings::get(editorState, AnalyzerSettings::Smoothing);
+    auto bandsPerOctave = smoothingIndex == 0 ? 0 : 3 << (smoothingIndex - 1);
+    
+    for( auto* producer : { &leftPathProducer, &rightPathProducer } )
+    {
+        producer->setResponse(response);
+        producer->setBandsPerOctave(bandsPerOctave);
+    }
+}
+
 void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
 {
     parametersChanged.set(true);
 }
 
-
-void SpectrumAnalyzer::timerCallback()
+void SpectrumAnalyzer::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property)
 {
-    if( shouldShowFFTAnalysis )
-    {
-        auto bounds = getLocalBounds();
-        auto fftBounds = getAnalysisArea(bounds).toFloat();
-        fftBounds.setBottom(bounds.getBottom());
-        auto sampleRate = audioProcessor.getSampleRate();
-        
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
-    }
-
-    if( parametersChanged.compareAndSetBool(false, true) )
-    {
-        
-    }
-    
-    repaint();
+    if( AnalyzerSettings::isSetting(property) )
+        parametersChanged.set(true);
 }
 
 
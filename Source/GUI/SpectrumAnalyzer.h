@@ -15,7 +15,7 @@
 
 struct SpectrumAnalyzer: juce::Component,
 juce::AudioProcessorParameter::Listener,
-juce::Timer
+juce::ValueTree::Listener
 {
     SpectrumAnalyzer(MultibandCompressorAudioProcessor&);
     ~SpectrumAnalyzer();
@@ -24,23 +24,54 @@ juce::Timer
 
     void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
     
-    void timerCallback() override;
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
     
     void paint(juce::Graphics& g) override;
     void resized() override;
     
+    /**
+     shows or hides the FFT curves. the next update() reports the change, so an idling editor
+     goes back to its active frame rate and starts pulling analysis frames again.
+     */
     void toggleAnalysisEnablement(bool enabled)
     {
+        if( shouldShowFFTAnalysis == enabled )
+            return;
+        
         shouldShowFFTAnalysis = enabled;
+        analysisEnablementChanged = true;
+        repaint();
     }
     
-    void update(const std::vector<float>& values);
+    /**
+     pulls any new analysis frames and the latest gain reduction, and repaints the analysis area
+     if anything visible changed. returns false when there was nothing new to draw.
+     */
+    bool update(const std::array<GainReductionTelemetry::Reading, 3>& gainReduction);
     
+    /**
+     both path producers add their stage timings from update() to 'times', see PathProducer::StageTimes
+     */
+    void setStageTimes(PathProducer::StageTimes* times)
+    {
+        leftPathProducer.setStageTimes(times);
+        rightPathProducer.setStageTimes(times);
+    }
+    
+    /**
+     true once both channels are drawing with the resolution in the current AnalyzerSettings.
+     a change is built on a background thread and picked up by a later update().
+     */
+    bool isResolutionReady() const { return leftPathProducer.isResolutionReady() && rightPathProducer.isResolutionReady(); }
+    
+    FFTOrder getFFTOrder() const { return leftPathProducer.getOrder(); }
+    bool isMultiResolution() const { return leftPathProducer.isMultiResolution(); }
     
 private:
     MultibandCompressorAudioProcessor& audioProcessor;
 
     bool shouldShowFFTAnalysis = true;
+    bool analysisEnablementChanged = false;
 
     juce::Atomic<bool> parametersChanged { false };
     
@@ -67,6 +98,12 @@ private:
     void drawCrossovers(juce::Graphics& g,
                          juce::Rectangle<int> bounds);
     
+    juce::Image backgroundLayer, labelLayer;
+    float layerScale {0.f};
+    juce::Rectangle<int> moduleBounds;
+    
+    void updateLayers(float scale);
+    
     juce::AudioParameterFloat* lowMidXoverParam {nullptr};
     juce::AudioParameterFloat* midHighXoverParam {nullptr};
     
@@ -74,7 +111,11 @@ private:
     juce::AudioParameterFloat* midThresholdParam {nullptr};
     juce::AudioParameterFloat* highThresholdParam {nullptr};
     
-    float lowBandGR {0.f};
-    float midBandGR {0.f};
-    float highBandGR {0.f};
+    //the processor's editorState, where the AnalyzerSettings live
+    juce::ValueTree editorState;
+    
+    void updateAnalyzerSettings();
+    
+    //low, mid, high
+    std::array<GainReductionTelemetry::Reading, 3> bandGainReduction;
 };
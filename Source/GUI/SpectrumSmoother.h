@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    SpectrumSmoother.h
+    Created: 19 Oct 2026 1:22:18pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/**
+ post-processes the dB spectrum from FFTDataGenerator before it's turned into a path:
+ optional 1/N-octave smoothing, followed by exponential averaging or a decaying peak hold.
+ */
+struct SpectrumSmoother
+{
+    enum class Response
+    {
+        Raw,
+        Average,
+        PeakHold
+    };
+    
+    void setResponse(Response newResponse)
+    {
+        if( newResponse == response )
+            return;
+        
+        response = newResponse;
+        state.clear(); //restart from the next frame
+    }
+    
+    /**
+     0 turns smoothing off, otherwise each bin becomes the mean of the bins within
+     1/bandsPerOctave of an octave around it.
+     */
+    void setBandsPerOctave(int newBandsPerOctave)
+    {
+        if( newBandsPerOctave == bandsPerOctave )
+            return;
+        
+        bandsPerOctave = newBandsPerOctave;
+        boundsNumBins = 0;
+    }
+    
+    /**
+     processes 'numBins' dB values in place. 'frameSeconds' is the time since the previous frame.
+     */
+    void process(float* data, int numBins, float frameSeconds)
+    {
+        if( bandsPerOctave > 0 )
+            smooth(data, numBins);
+        
+        if( response == Response::Raw )
+            return;
+        
+        if( (int)state.size() != numBins )
+        {
+            state.assign(data, data + numBins);
+            return;
+        }
+        
+        if( response == Response::Average )
+        {
+            //state += alpha * (data - state)
+            auto alpha = 1.f - std::exp(-frameSeconds / averagingTimeSeconds);
+            juce::FloatVectorOperations::multiply(state.data(), 1.f - alpha, numBins);
+            juce::FloatVectorOperations::addWithMultiply(state.data(), data, alpha, numBins);
+        }
+        else
+        {
+            //state = max(state - decay, data)
+            juce::FloatVectorOperations::add(state.data(), -peakDecayDbPerSecond * frameSeconds, numBins);
+            juce::FloatVectorOperations::max(state.data(), state.data(), data, numBins);
+        }
+        
+        juce::FloatVectorOperations::copy(data, state.data(), numBins);
+    }
+    
+private:
+    static constexpr float averagingTimeSeconds = 0.3f;
+    static constexpr float peakDecayDbPerSecond = 12.f;
+    
+    Response response {Response::Raw};
+    int bandsPerOctave {0};
+    
+    std::vector<float> state;
+    
+    std::vector<int> lowerBin, upperBin;
+    std::vector<double> prefixSum;
+    int boundsNumBins {0};
+    
+    /**
+     with a running sum over the bins, every bin's band mean is one subtraction and one multiply,
+     however many bins the band spans. the band edges only change with the bin count, so they're cached.
+     */
+    void smooth(float* data, int numBins)
+    {
+        if( numBins != boundsNumBins )
+            updateBounds(numBins);
+        
+        prefixSum[0] = 0.0;
+        for( int bin = 0; bin < numBins; ++bin )
+        {
+            prefixSum[bin + 1] = prefixSum[bin] + data[bin];
+        }
+        
+        for( int bin = 0; bin < numBins; ++bin )
+        {
+            auto lo = lowerBin[bin];
+            auto hi = upperBin[bin];
+            data[bin] = float((prefixSum[hi] - prefixSum[lo]) / double(hi - lo));
+        }
+    }
+    
+    void updateBounds(int numBins)
+    {
+        boundsNumBins = numBins;
+        
+        lowerBin.resize(numBins);
+        upperBin.resize(numBins);
+        prefixSum.resize(numBins + 1);
+        
+        auto halfBand = std::pow(2.0, 0.5 / bandsPerOctave);
+        
+        for( int bin = 0; bin < numBins; ++bin )
+        {
+            //[lower, upper) always contains the bin itself
+            lowerBin[bin] = juce::jlimit(0, bin, (int)std::round(bin / halfBand));
+            upperBin[bin] = juce::jlimit(bin + 1, numBins, (int)std::round(bin * halfBand) + 1);
+        }
+    }
+};
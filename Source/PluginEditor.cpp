@@ -17,14 +17,34 @@ MultibandCompressorAudioProcessorEditor::MultibandCompressorAudioProcessorEditor
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
     setLookAndFeel(&lnf);
-    //addAndMakeVisible(controlBar);
+    addAndMakeVisible(controlBar);
     addAndMakeVisible(analyzer);
+    addAndMakeVisible(gainReductionHistory);
     addAndMakeVisible(globalcontrols);
     addAndMakeVisible(bandControls);
+    
+    globalcontrols.onStoreSnapshot = [this](int snapshot)
+    {
+        audioProcessor.storeSnapshot(snapshot);
+        updateSnapshotControls();
+    };
+    
+    globalcontrols.onClearSnapshots = [this]
+    {
+        audioProcessor.clearSnapshots();
+        updateSnapshotControls();
+    };
+    
+    //everything's different from what's "shown" to begin with, so it's all shown once
+    for( int i = 0; i < SnapshotMorph::numSnapshots; ++i )
+        shownSnapshotsStored[(size_t)i] = !audioProcessor.snapshotMorph.isStored(i);
+    
+    shownMorphEngaged = !audioProcessor.snapshotMorph.isEngaged();
+    updateSnapshotControls();
 
-    setSize (600, 500);
+    setSize (600, 560);
     
-    startTimerHz(60);
+    startTimerHz(currentRefreshRateHz);
 }
 
 MultibandCompressorAudioProcessorEditor::~MultibandCompressorAudioProcessorEditor()
@@ -55,22 +75,65 @@ void MultibandCompressorAudioProcessorEditor::resized()
     
     analyzer.setBounds(bounds.removeFromTop(225));
     
+    gainReductionHistory.setBounds(bounds.removeFromTop(60));
+    
     globalcontrols.setBounds(bounds);
 }
 
 void MultibandCompressorAudioProcessorEditor::timerCallback()
 {
-    std::vector<float> values
+    MULTIBAND_TRACE_SCOPE("editor timerCallback");
+    
+    //fixed size so the frame clock itself never allocates
+    std::array<GainReductionTelemetry::Reading, 3> gainReduction
     {
-        audioProcessor.lowBandComp.getRMSInputLebelDb(),
-        audioProcessor.lowBandComp.getRMSOutputLebelDb(),
-        audioProcessor.midBandComp.getRMSInputLebelDb(),
-        audioProcessor.midBandComp.getRMSOutputLebelDb(),
-        audioProcessor.highBandComp.getRMSInputLebelDb(),
-        audioProcessor.highBandComp.getRMSOutputLebelDb()
-        
+        audioProcessor.lowBandComp.getGainReduction(),
+        audioProcessor.midBandComp.getGainReduction(),
+        audioProcessor.highBandComp.getGainReduction()
     };
     
-    analyzer.update(values);
+    //this is the editor's only frame clock. it drops to the idle rate once
+    //nothing has needed a repaint for a while, and goes back up on the next change.
+    auto somethingChanged = analyzer.update(gainReduction);
+    somethingChanged |= gainReductionHistory.update();
+    somethingChanged |= controlBar.update();
+    somethingChanged |= updateSnapshotControls();
+    
+    framesWithoutChanges = somethingChanged ? 0 : framesWithoutChanges + 1;
+    
+    auto refreshRate = framesWithoutChanges < framesBeforeIdling ? activeRefreshRateHz : idleRefreshRateHz;
+    if( refreshRate != currentRefreshRateHz )
+    {
+        currentRefreshRateHz = refreshRate;
+        startTimerHz(currentRefreshRateHz);
+    }
+}
+
+bool MultibandCompressorAudioProcessorEditor::updateSnapshotControls()
+{
+    auto changed = false;
+    auto& morph = audioProcessor.snapshotMorph;
+    
+    for( int i = 0; i < SnapshotMorph::numSnapshots; ++i )
+    {
+        auto stored = morph.isStored(i);
+        if( stored != shownSnapshotsStored[(size_t)i] )
+        {
+            shownSnapshotsStored[(size_t)i] = stored;
+            globalcontrols.setSnapshotStored(i, stored);
+            changed = true;
+        }
+    }
+    
+    auto engaged = morph.isEngaged();
+    if( engaged != shownMorphEngaged )
+    {
+        shownMorphEngaged = engaged;
+        globalcontrols.setMorphEngaged(engaged);
+        bandControls.setMorphEngaged(engaged);
+        changed = true;
+    }
+    
+    return changed;
 }
 //==============================================================================
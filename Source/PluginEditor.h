@@ -15,6 +15,8 @@
 #include "GUI/CompressorBandControls.h"
 #include "GUI/UtilityComponents.h"
 #include "GUI/SpectrumAnalyzer.h"
+#include "GUI/ControlBar.h"
+#include "GUI/GainReductionHistory.h"
 
 
 /**
@@ -37,10 +39,27 @@ private:
     LookAndFeel lnf;
     MultibandCompressorAudioProcessor& audioProcessor;
     
-    Placeholder controlBar/*, analyzer globalControls bandControls;*/;
+    ControlBar controlBar{audioProcessor};
     GlobalControls globalcontrols{audioProcessor.apvts};
     CompressorBandControls bandControls{audioProcessor.apvts};
     SpectrumAnalyzer analyzer{audioProcessor};
+    GainReductionHistory gainReductionHistory{audioProcessor};
+    
+    static constexpr int activeRefreshRateHz = 60;
+    static constexpr int idleRefreshRateHz = 10;
+    static constexpr int framesBeforeIdling = 30;
+    
+    int currentRefreshRateHz {activeRefreshRateHz};
+    int framesWithoutChanges {0};
+    
+    //what the snapshot controls last showed. a loaded session can change it, so it's polled.
+    std::array<bool, SnapshotMorph::numSnapshots> shownSnapshotsStored {};
+    bool shownMorphEngaged {false};
+    
+    /**
+     brings the snapshot buttons and the dimmed knobs up to date, returns true if anything changed
+     */
+    bool updateSnapshotControls();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultibandCompressorAudioProcessorEditor)
 };
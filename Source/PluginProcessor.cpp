@@ -23,64 +23,38 @@ MultibandCompressorAudioProcessor::MultibandCompressorAudioProcessor()
                        )
 #endif
 {
-    //Retrieve APVTS stored paramaters and assign them to cached pointers    //Assert that parameter names are spelt correctly
-    
+    //Retrieve APVTS stored paramaters and assign them to cached pointers
+    //the registry in Params.h knows where each one is and what type it is, so there's no lookup by name
     using namespace Params;
-    const auto& params = GetParams();
-    
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
-        jassert(param !=nullptr);
-    };
-    
-    floatHelper(lowBandComp.attack, Names::Attack_Low_Band);
-    floatHelper(lowBandComp.release, Names::Release_Low_Band);
-    floatHelper(lowBandComp.threshold, Names::Threshold_Low_Band);
-    
-    floatHelper(midBandComp.attack, Names::Attack_Mid_Band);
-    floatHelper(midBandComp.release, Names::Release_Mid_Band);
-    floatHelper(midBandComp.threshold, Names::Threshold_Mid_Band);
-    
-    floatHelper(highBandComp.attack, Names::Attack_High_Band);
-    floatHelper(highBandComp.release, Names::Release_High_Band);
-    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
-    
     
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
+    for( int band = 0; band < numBands; ++band )
     {
-        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
-        jassert(param !=nullptr);
-    };
-    
-    choiceHelper(lowBandComp.ratio, Names::Ratio_Low_Band);
-    choiceHelper(midBandComp.ratio, Names::Ratio_Mid_Band);
-    choiceHelper(highBandComp.ratio, Names::Ratio_High_Band);
-    
-
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert(param !=nullptr);
-    };
+        auto& comp = compressors[(size_t)band];
+        
+        bind(comp.attack, *this, forBand(Attack_Low_Band, band));
+        bind(comp.release, *this, forBand(Release_Low_Band, band));
+        bind(comp.threshold, *this, forBand(Threshold_Low_Band, band));
+        bind(comp.ratio, *this, forBand(Ratio_Low_Band, band));
+        bind(comp.bypassed, *this, forBand(Bypassed_Low_Band, band));
+        bind(comp.mute, *this, forBand(Mute_Low_Band, band));
+        bind(comp.solo, *this, forBand(Solo_Low_Band, band));
+    }
     
-    boolHelper(lowBandComp.bypassed, Names::Bypassed_Low_Band);
-    boolHelper(midBandComp.bypassed, Names::Bypassed_Mid_Band);
-    boolHelper(highBandComp.bypassed, Names::Bypassed_High_Band);
+    lowMidCrossover = &getParam<Low_Mid_Crossover_Freq>(*this);
+    midHighCrossover = &getParam<Mid_High_Crossover_Freq>(*this);
     
-    boolHelper(lowBandComp.mute, Names::Mute_Low_Band);
-    boolHelper(midBandComp.mute, Names::Mute_Mid_Band);
-    boolHelper(highBandComp.mute, Names::Mute_High_Band);
+    inputGainParam = &getParam<Gain_in>(*this);
+    outputGainParam = &getParam<Gain_out>(*this);
     
-    boolHelper(lowBandComp.solo, Names::Solo_Low_Band);
-    boolHelper(midBandComp.solo, Names::Solo_Mid_Band);
-    boolHelper(highBandComp.solo, Names::Solo_High_Band);
+    truePeakLimiterParam = &getParam<True_Peak_Limiter>(*this);
+    truePeakCeilingParam = &getParam<True_Peak_Ceiling>(*this);
+    morphParam = &getParam<Morph>(*this);
     
-    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
+    for( int i = 0; i < NumParams; ++i )
+        parametersByName[(size_t)i] = &getParam(*this, Names(i));
     
-    floatHelper(inputGainParam, Names::Gain_in);
-    floatHelper(outputGainParam, Names::Gain_out);
+    //no bank just means the single default program
+    presetBank.open(PresetBank::getDefaultFile());
 
     
     LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
@@ -94,12 +68,59 @@ MultibandCompressorAudioProcessor::MultibandCompressorAudioProcessor()
 //    invAP1.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
 //    invAP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
 
+    saveEditorState();
+    editorState.addListener(this);
     
-
+   #if MULTIBAND_TRACING
+    //every instance in the process shares the recorder, the first one to see the variable starts it
+    auto traceFile = juce::SystemStats::getEnvironmentVariable("MULTIBAND_TRACE_FILE", {});
+    if( traceFile.isNotEmpty() && !traceRecorder->isRecording() )
+        traceRecorder->start(juce::File(traceFile));
+   #endif
 }
 
 MultibandCompressorAudioProcessor::~MultibandCompressorAudioProcessor()
 {
+    cancelPendingUpdate();
+    editorState.removeListener(this);
+}
+
+void MultibandCompressorAudioProcessor::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&)
+{
+    saveEditorState();
+}
+
+void MultibandCompressorAudioProcessor::saveEditorState()
+{
+    juce::MemoryBlock data;
+    {
+        juce::MemoryOutputStream out(data, false);
+        editorState.writeToStream(out);
+    }
+    
+    const juce::ScopedLock lock(savedEditorStateLock);
+    savedEditorState.swapWith(data);
+}
+
+void MultibandCompressorAudioProcessor::handleAsyncUpdate()
+{
+    applySavedEditorState();
+}
+
+void MultibandCompressorAudioProcessor::applySavedEditorState()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    juce::ValueTree tree;
+    {
+        const juce::ScopedLock lock(savedEditorStateLock);
+        tree = juce::ValueTree::readFromData(savedEditorState.getData(), savedEditorState.getSize());
+    }
+    
+    if( tree.hasType(editorState.getType()) )
+        editorState.copyPropertiesFrom(tree, nullptr);
+    else
+        editorState.removeAllProperties(nullptr);
 }
 
 //==============================================================================
@@ -142,22 +163,27 @@ double MultibandCompressorAudioProcessor::getTailLengthSeconds() const
 
 int MultibandCompressorAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    return juce::jmax(1, presetBank.getNumPresets());   // NB: some hosts don't cope very well if you tell them there are 0 programs,
                 // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int MultibandCompressorAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
 void MultibandCompressorAudioProcessor::setCurrentProgram (int index)
 {
+    //the audio thread sees either all of the old preset or all of the new one
+    SeqLock::ScopedWrite write(presetApply);
+    
+    if( presetBank.apply(index, parametersByName) )
+        currentProgram = index;
 }
 
 const juce::String MultibandCompressorAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presetBank.getName(index);
 }
 
 void MultibandCompressorAudioProcessor::changeProgramName (int index, const juce::String& newName)
@@ -169,7 +195,7 @@ void MultibandCompressorAudioProcessor::prepareToPlay (double sampleRate, int sa
 {
 //
     juce::dsp::ProcessSpec spec; // Create process spec object --> needed to initialised DSP -->
-    spec.maximumBlockSize = samplesPerBlock; // set max number of samples to be processed
+    spec.maximumBlockSize = subBlockSize; // the DSP only ever sees sub-blocks, whatever the host sends
     spec.numChannels = getTotalNumOutputChannels();  //Number of channels to be configured to compressed
     spec.sampleRate = sampleRate; //Sample rate
     
@@ -196,13 +222,34 @@ void MultibandCompressorAudioProcessor::prepareToPlay (double sampleRate, int sa
     inputGain.setRampDurationSeconds(0.05);
     outputGain.setRampDurationSeconds(0.05);
     
+    morphPosition.reset(sampleRate, 0.05);
+    morphPosition.setCurrentAndTargetValue(morphParam->get() / 100.f);
+    morphAmount.reset(sampleRate, 0.05);
+    morphAmount.setCurrentAndTargetValue(snapshotMorph.isEngaged() ? 1.f : 0.f);
+    
     for(auto& buffer: filterBuffers)
     {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
+        buffer.setSize(spec.numChannels, subBlockSize);
     }
     
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    //starts out as a cell of silence for the first one to hand back
+    cellBuffer.setSize(spec.numChannels, subBlockSize);
+    cellBuffer.clear();
+    cellFill = 0;
+    
+    truePeakLimiter.prepare(sampleRate, spec.numChannels, subBlockSize);
+    dspLoad.prepare(sampleRate, samplesPerBlock);
+    
+    pendingHistoryBlock = {};
+    
+    //the limiter delays its output the same amount whether it's on or off
+    setLatencySamples(subBlockSize + truePeakLimiter.getLatencySamples());
+    
+    loudnessMeter.prepare(sampleRate, getTotalNumOutputChannels());
+    
+    //the fifos take samples one at a time, so their buffer size is the analyzer's hop, not the host's block
+    leftChannelFifo.prepare(analyzerHopSize);
+    rightChannelFifo.prepare(analyzerHopSize);
     
     osc.initialise([](float x) {return std::sin(x); });
     osc.prepare(spec);
@@ -245,30 +292,107 @@ bool MultibandCompressorAudioProcessor::isBusesLayoutSupported (const BusesLayou
 }
 #endif
 
+MultibandCompressorAudioProcessor::Settings MultibandCompressorAudioProcessor::readSettings() const
+{
+    Settings s;
+    
+    for(size_t i = 0; i < compressors.size(); ++i)
+        s.bands[i] = compressors[i].readSettings();
+    
+    s.lowMidCrossoverHz = lowMidCrossover->get();
+    s.midHighCrossoverHz = midHighCrossover->get();
+    s.inputGainDb = inputGainParam->get();
+    s.outputGainDb = outputGainParam->get();
+    s.truePeakLimiter = truePeakLimiterParam->get();
+    s.truePeakCeilingDb = truePeakCeilingParam->get();
+    s.morph = morphParam->get() / 100.f;
+    
+    return s;
+}
+
+MultibandCompressorAudioProcessor::Settings MultibandCompressorAudioProcessor::getMorphedSettings(float position, float amount) const
+{
+    using namespace Params;
+    
+    //switches and the morph itself stay as the parameters have them
+    auto s = liveSettings;
+    
+    auto morph = [this, position, amount](int name, float& live)
+    {
+        auto morphed = snapshotMorph.getValue(Names(name), position);
+        live = SnapshotMorph::interpolate(Names(name), live, morphed, amount);
+    };
+    
+    for(size_t i = 0; i < s.bands.size(); ++i)
+    {
+        morph(Attack_Low_Band + (int)i, s.bands[i].attackMs);
+        morph(Release_Low_Band + (int)i, s.bands[i].releaseMs);
+        morph(Threshold_Low_Band + (int)i, s.bands[i].thresholdDb);
+        morph(Ratio_Low_Band + (int)i, s.bands[i].ratio);
+    }
+    
+    morph(Low_Mid_Crossover_Freq, s.lowMidCrossoverHz);
+    morph(Mid_High_Crossover_Freq, s.midHighCrossoverHz);
+    morph(Gain_in, s.inputGainDb);
+    morph(Gain_out, s.outputGainDb);
+    morph(True_Peak_Ceiling, s.truePeakCeilingDb);
+    
+    return s;
+}
+
 void MultibandCompressorAudioProcessor::updateState() {
     
-    for(auto& compressor: compressors) {
-        compressor.updateCompressorSettings();
+    //a preset that's being applied is never seen half way through, the block keeps the last settings instead
+    Settings settings;
+    if( !presetApply.tryRead([this, &settings] { settings = readSettings(); }) )
+        return;
+    
+    liveSettings = settings;
+    
+    //once both snapshots are stored the continuous parameters come from the morph.
+    //storing or clearing them ramps between the knobs and the morph like the morph itself moves.
+    morphing = snapshotMorph.update();
+    morphAmount.setTargetValue(morphing ? 1.f : 0.f);
+    
+    if( morphing )
+        morphPosition.setTargetValue(settings.morph);
+    else if( !morphAmount.isSmoothing() )
+        morphPosition.setCurrentAndTargetValue(settings.morph);
+    
+    if( morphing || morphAmount.isSmoothing() )
+        applySettings(getMorphedSettings(morphPosition.getCurrentValue(), morphAmount.getCurrentValue()));
+    else
+        applySettings(settings);
+}
+
+void MultibandCompressorAudioProcessor::applySettings(const Settings& settings)
+{
+    for(size_t i = 0; i < compressors.size(); ++i) {
+        compressors[i].updateCompressorSettings(settings.bands[i]);
     }
     
-    auto lowMidCutoffFreq = lowMidCrossover->get();
+    auto lowMidCutoffFreq = settings.lowMidCrossoverHz;
     LP1.setCutoffFrequency(lowMidCutoffFreq);
     HP1.setCutoffFrequency(lowMidCutoffFreq);
     
-    auto midHighCutoffFreq = midHighCrossover->get();
+    auto midHighCutoffFreq = settings.midHighCrossoverHz;
     AP2.setCutoffFrequency(midHighCutoffFreq);
     LP2.setCutoffFrequency(midHighCutoffFreq);
     HP2.setCutoffFrequency(midHighCutoffFreq);
     
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
+    inputGain.setGainDecibels(settings.inputGainDb);
+    outputGain.setGainDecibels(settings.outputGainDb);
     
+    truePeakLimiter.setEnabled(settings.truePeakLimiter);
+    truePeakLimiter.setCeilingDb(settings.truePeakCeilingDb);
 }
 
 void MultibandCompressorAudioProcessor::splitBands(const juce::AudioBuffer<float> &inputBuffer) {
+    //copy assignment reallocates whenever the block size changes, makeCopyOf keeps the
+    //storage prepareToPlay sized for subBlockSize
     for(auto& fb: filterBuffers)
     {
-        fb = inputBuffer;
+        fb.makeCopyOf(inputBuffer, true);
     }
     auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
     auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
@@ -282,53 +406,15 @@ void MultibandCompressorAudioProcessor::splitBands(const juce::AudioBuffer<float
     AP2.process(fb0Ctx);
     
     HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
+    filterBuffers[2].makeCopyOf(filterBuffers[1], true);
     LP2.process(fb1Ctx);
     
     HP2.process(fb2Ctx);
     
     
 }
-void MultibandCompressorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void MultibandCompressorAudioProcessor::sumBands(juce::AudioBuffer<float>& buffer)
 {
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
-    updateState();
-    
-    if(false)
-    {
-        buffer.clear();
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        osc.process(ctx);
-        
-        gain.process(ctx);
-    }
-    
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
-    
-    applyGain(buffer, inputGain);
-        
-    splitBands(buffer);
-    
-    for(size_t i =0 ;i < filterBuffers.size(); ++i)
-    {
-        compressors[i].process(filterBuffers[i]);
-    }
-    
-    
     auto numSamples = buffer.getNumSamples();
     auto NumChannels = buffer.getNumChannels();
     
@@ -346,7 +432,7 @@ void MultibandCompressorAudioProcessor::processBlock (juce::AudioBuffer<float>&
     auto bandsAreSoloed = false;
     for(auto& comp: compressors)
     {
-        if(comp.solo->get())
+        if(comp.getSettings().solo)
         {
             bandsAreSoloed = true;
             break;
@@ -358,7 +444,7 @@ void MultibandCompressorAudioProcessor::processBlock (juce::AudioBuffer<float>&
         for(size_t i=0; i < compressors.size(); ++i)
         {
             auto& comp = compressors[i];
-            if(comp.solo->get())
+            if(comp.getSettings().solo)
             {
                 addFilterBand(buffer, filterBuffers[i]);
             }
@@ -369,14 +455,162 @@ void MultibandCompressorAudioProcessor::processBlock (juce::AudioBuffer<float>&
         for(size_t i=0; i < compressors.size(); ++i)
         {
             auto& comp = compressors[i];
-            if(!comp.mute->get())
+            if(!comp.getSettings().mute)
             {
                 addFilterBand(buffer, filterBuffers[i]);
             }
         }
     }
+}
+
+void MultibandCompressorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    MULTIBAND_TRACE_SCOPE("processBlock");
+    
+    //an offline render is allowed to take longer than the audio lasts
+    std::optional<DSPLoadMeter::ScopedTimer> loadTimer;
+    if( !isNonRealtime() )
+        loadTimer.emplace(dspLoad, buffer.getNumSamples());
+    
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    applyGain(buffer,outputGain);
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+   #if MULTIBAND_STAGE_TIMING
+    stageProfiler.beginBlock();
+   #endif
+    
+    //parameters are read once per host block, the sub-blocks all use the same settings
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, UpdateState);
+        updateState();
+    }
+    
+    if(false)
+    {
+        buffer.clear();
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        osc.process(ctx);
+        
+        gain.process(ctx);
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, AnalyzerFifos);
+        leftChannelFifo.update(buffer);
+        rightChannelFifo.update(buffer);
+    }
+    
+    //each host sample swaps places with the processed sample a cell earlier, and a full cell is
+    //processed in place. the DSP only ever sees whole, aligned cells, on a grid that doesn't
+    //move with the host's block boundaries.
+    const auto numSamples = buffer.getNumSamples();
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), cellBuffer.getNumChannels());
+    auto numCells = 0;
+    
+    for( int start = 0; start < numSamples; )
+    {
+        auto length = juce::jmin(subBlockSize - cellFill, numSamples - start);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            auto* host = buffer.getWritePointer(ch, start);
+            std::swap_ranges(host, host + length, cellBuffer.getWritePointer(ch, cellFill));
+        }
+        
+        start += length;
+        cellFill += length;
+        
+        if( cellFill == subBlockSize )
+        {
+            processSubBlock(cellBuffer);
+            cellFill = 0;
+            ++numCells;
+        }
+    }
+    
+    auto& history = pendingHistoryBlock;
+    
+    //a block too short to finish a cell leaves the meters and the history to the next one
+    for(size_t i = 0; i < compressors.size() && numCells > 0; ++i)
+    {
+        compressors[i].finishBlock();
+        
+        auto range = compressors[i].getLastBlockGainReductionRange();
+        auto isFirstBlock = history.numSamples == 0;
+        history.deepestDb[i] = isFirstBlock ? range.getStart() : juce::jmin(history.deepestDb[i], range.getStart());
+        history.shallowestDb[i] = isFirstBlock ? range.getEnd() : juce::jmax(history.shallowestDb[i], range.getEnd());
+    }
+    
+    history.numSamples += numCells * subBlockSize;
+    
+    //if no editor is draining it the fifo just fills up and the blocks are dropped
+    if( history.numSamples >= historyBlockSize )
+    {
+        gainReductionHistoryFifo.push(history);
+        history = {};
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, Loudness);
+        loudnessMeter.process(buffer);
+    }
+}
+
+void MultibandCompressorAudioProcessor::processSubBlock(juce::AudioBuffer<float>& buffer)
+{
+    jassert(buffer.getNumSamples() == subBlockSize);
+    
+    //while the morph, or the switch between it and the knobs, moves the settings are
+    //recalculated once per cell, not per sample
+    if( morphPosition.isSmoothing() || morphAmount.isSmoothing() )
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, UpdateState);
+        morphPosition.skip(buffer.getNumSamples());
+        morphAmount.skip(buffer.getNumSamples());
+        applySettings(getMorphedSettings(morphPosition.getCurrentValue(), morphAmount.getCurrentValue()));
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, InputGain);
+        applyGain(buffer, inputGain);
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, SplitBands);
+        splitBands(buffer);
+    }
+    
+    for(size_t i = 0; i < filterBuffers.size(); ++i)
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, CompressLow + (int)i);
+        compressors[i].process(filterBuffers[i]);
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, Sum);
+        sumBands(buffer);
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, OutputGain);
+        applyGain(buffer,outputGain);
+    }
+    
+    {
+        MULTIBAND_TIME_STAGE(stageProfiler, Limiter);
+        truePeakLimiter.process(buffer);
+    }
 }
 
 //==============================================================================
@@ -399,9 +633,13 @@ void MultibandCompressorAudioProcessor::getStateInformation (juce::MemoryBlock&
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
     
-    //get the state information from parameters
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    //raw parameter values, much quicker to write and read back than the APVTS tree
+    ParameterState::write(parametersByName, destData);
+    snapshotMorph.write(destData);
+    
+    //then the editor's settings, which are few and only read on load
+    const juce::ScopedLock lock(savedEditorStateLock);
+    destData.append(savedEditorState.getData(), savedEditorState.getSize());
 }
 
 
@@ -410,6 +648,39 @@ void MultibandCompressorAudioProcessor::setStateInformation (const void* data, i
 // You should use this method to restore your parameters from this memory block,
 // whose contents will have been created by the getStateInformation() call.
     
+    //the editor's settings reach editorState on the message thread, now if this is it
+    auto setEditorState = [this](const void* editorData, size_t editorSize)
+    {
+        {
+            const juce::ScopedLock lock(savedEditorStateLock);
+            savedEditorState.replaceAll(editorData, editorSize);
+        }
+        
+        if( juce::MessageManager::existsAndIsCurrentThread() )
+            applySavedEditorState();
+        else
+            triggerAsyncUpdate();
+    };
+    
+    if( auto numBytes = ParameterState::read(parametersByName, data, sizeInBytes) )
+    {
+        //the A/B snapshots follow the values, then the editor's settings, if there are any
+        auto* bytes = static_cast<const char*>(data);
+        numBytes += snapshotMorph.read(parametersByName, bytes + numBytes, sizeInBytes - numBytes);
+        
+        setEditorState(bytes + numBytes, (size_t)(sizeInBytes - numBytes));
+        return;
+    }
+    
+    //data in the binary format that couldn't be read, because it's truncated or from a newer
+    //build, keeps the current settings rather than being misread as the older format
+    if( ParameterState::isThisFormat(data, sizeInBytes) )
+        return;
+    
+    //sessions saved before the binary state have the APVTS tree, no snapshots and no editor settings
+    snapshotMorph.read(parametersByName, nullptr, 0);
+    setEditorState(nullptr, 0);
+    
     //update the state information from audio parqamaters value tree
  auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
 
@@ -420,151 +691,8 @@ void MultibandCompressorAudioProcessor::setStateInformation (const void* data, i
 
 juce::AudioProcessorValueTreeState::ParameterLayout MultibandCompressorAudioProcessor::createParameterLayout()
 {
-    //define and add parameters
-    APVTS::ParameterLayout layout;
-
-    using namespace juce;
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    auto gainRange = NormalisableRange<float>(-24.f, 24.f, 0.5, 1);
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(ParameterID {params.at(Names::Gain_in), 1},
-                                                    params.at(Names::Gain_in),
-                                                    gainRange,
-                                                    0 ));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(ParameterID {params.at(Names::Gain_out), 1},
-                                                    params.at(Names::Gain_out),
-                                                    gainRange,
-                                                    0 ));
-
-
-    auto thresholdRange = juce::NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBELS, 1, 1);
-    layout.add(std::make_unique<juce::AudioParameterFloat>(ParameterID {params.at(Names::Threshold_Low_Band), 1},
-                                                    params.at(Names::Threshold_Low_Band),
-                                                    thresholdRange,
-                                                    0 ));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(ParameterID {params.at(Names::Threshold_Mid_Band), 1},
-                                                    params.at(Names::Threshold_Mid_Band),
-                                                    thresholdRange,
-                                                    0 ));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(ParameterID {params.at(Names::Threshold_High_Band), 1},
-                                                    params.at(Names::Threshold_High_Band),
-                                                    thresholdRange,
-                                                    0 ));
-
-
-    auto attackReleaseRange = juce::NormalisableRange<float>(5, 500, 1, 1);
-
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Attack_Low_Band),1},
-                                                    params.at(Names::Attack_Low_Band),
-                                                    attackReleaseRange,
-                                                    50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Attack_Mid_Band),1},
-                                                    params.at(Names::Attack_Mid_Band),
-                                                    attackReleaseRange,
-                                                    50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Attack_High_Band),1},
-                                                    params.at(Names::Attack_High_Band),
-                                                    attackReleaseRange,
-                                                    50));
-
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Release_Low_Band), 1},
-                                                    params.at(Names::Release_Low_Band),
-                                                    attackReleaseRange,
-                                                    250));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Release_Mid_Band), 1},
-                                                    params.at(Names::Release_Mid_Band),
-                                                    attackReleaseRange,
-                                                    250));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Release_High_Band), 1},
-                                                    params.at(Names::Release_High_Band),
-                                                    attackReleaseRange,
-                                                    250));
-    
-
-    auto choices = std::vector<double>{1,1.5,2,3,4,5,6,7,8,10,15,20,50,100};
-
-    juce::StringArray sa;
-    for (auto choice : choices)
-    {
-        sa.add(juce::String(choice, 1));
-    }
-
-    layout.add(std::make_unique<AudioParameterChoice>(ParameterID {params.at(Names::Ratio_Low_Band), 1},
-                                                      params.at(Names::Ratio_Low_Band),
-                                                      sa,
-                                                      3 ));
-    
-    layout.add(std::make_unique<AudioParameterChoice>(ParameterID {params.at(Names::Ratio_Mid_Band), 1},
-                                                      params.at(Names::Ratio_Mid_Band),
-                                                      sa,
-                                                      3 ));
-    
-    layout.add(std::make_unique<AudioParameterChoice>(ParameterID {params.at(Names::Ratio_High_Band), 1},
-                                                      params.at(Names::Ratio_High_Band),
-                                                      sa,
-                                                      3 ));
-    
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Bypassed_Low_Band), 1},
-                                                    params.at(Names::Bypassed_Low_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Bypassed_Mid_Band), 1},
-                                                    params.at(Names::Bypassed_Mid_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Bypassed_High_Band), 1},
-                                                    params.at(Names::Bypassed_High_Band),
-                                                    false));
-    
-    //mute
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Mute_Low_Band), 1},
-                                                    params.at(Names::Mute_Low_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Mute_Mid_Band), 1},
-                                                    params.at(Names::Mute_Mid_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Mute_High_Band), 1},
-                                                    params.at(Names::Mute_High_Band),
-                                                    false));
-    
-    
-    //solo
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Solo_Low_Band), 1},
-                                                    params.at(Names::Solo_Low_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Solo_Mid_Band), 1},
-                                                    params.at(Names::Solo_Mid_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(ParameterID {params.at(Names::Solo_High_Band), 1},
-                                                    params.at(Names::Solo_High_Band),
-                                                    false));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Low_Mid_Crossover_Freq), 1},
-                                                     params.at(Names::Low_Mid_Crossover_Freq),
-                                                     NormalisableRange<float>(MIN_FREQUENCY, 999, 1, 1), 400));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(ParameterID {params.at(Names::Mid_High_Crossover_Freq), 1},
-                                                     params.at(Names::Mid_High_Crossover_Freq),
-                                                     NormalisableRange<float>(1000, MAX_FREQUENCY, 1, 1), 2000));
-    
-    
-    
-    return layout;
+    //every parameter comes from the table in Params.h
+    return Params::createParameterLayout();
 }
 
 //==============================================================================
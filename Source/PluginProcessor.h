@@ -26,13 +26,23 @@
 #include <JuceHeader.h>
 #include "DSP/CompressorBand.h"
 #include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/LoudnessMeter.h"
+#include "DSP/TruePeakLimiter.h"
+#include "DSP/StageProfiler.h"
+#include "DSP/DSPLoadMeter.h"
+#include "DSP/ParameterState.h"
+#include "DSP/PresetBank.h"
+#include "DSP/SeqLock.h"
+#include "DSP/SnapshotMorph.h"
 
 
 
 //==============================================================================
 /**
 */
-class MultibandCompressorAudioProcessor  : public juce::AudioProcessor
+class MultibandCompressorAudioProcessor  : public juce::AudioProcessor,
+                                           private juce::ValueTree::Listener,
+                                           private juce::AsyncUpdater
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -51,6 +61,18 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    
+    /**
+     the DSP runs on cells of exactly this many samples whatever block size the host sends, so
+     the filters and compressors always work on the same sized, preallocated buffers. the host's
+     samples are gathered into a cell and come back out a cell later, which adds this much latency.
+     */
+    static constexpr int subBlockSize = 64;
+    
+    /**
+     samples per buffer the analyzer fifos hand to the UI
+     */
+    static constexpr int analyzerHopSize = 512;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -86,12 +108,50 @@ public:
     using BlockType = juce::AudioBuffer<float>;
         SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
         SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
+    
+    //each entry covers at least historyBlockSize samples however small the host's blocks are,
+    //so it holds 2.7 seconds at 192 kHz against the 100 ms between frames at the UI's idle rate
+    static constexpr int historyBlockSize = 256;
+    Fifo<GainReductionHistoryBlock, 2048> gainReductionHistoryFifo;
         
+    //both see what leaves processBlock, the limiter runs first
+    TruePeakLimiter truePeakLimiter;
+    LoudnessMeter loudnessMeter;
+    
+    //only measured when running in real time
+    DSPLoadMeter dspLoad;
+    
+    //A/B snapshots of every parameter, see SnapshotMorph
+    SnapshotMorph snapshotMorph;
+    
+    //settings that only change what the editor shows, like AnalyzerSettings. saved with the
+    //session but not host parameters. message thread only: the state methods, which a host can
+    //call from any thread, go through a saved copy instead.
+    juce::ValueTree editorState { "EditorState" };
+    
+    /**
+     stores the current settings as snapshot A (0) or B (1)
+     */
+    void storeSnapshot(int snapshot) { snapshotMorph.store(snapshot, parametersByName); }
+    
+    /**
+     forgets both snapshots, so the knobs set the continuous parameters again
+     */
+    void clearSnapshots() { snapshotMorph.clear(); }
+    
     std::array<CompressorBand, 3> compressors;
     CompressorBand& lowBandComp = compressors[0];
     CompressorBand& midBandComp = compressors[1];
     CompressorBand& highBandComp = compressors[2];
     
+   #if MULTIBAND_STAGE_TIMING
+    StageProfiler stageProfiler;
+   #endif
+    
+   #if MULTIBAND_TRACING
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;
+   #endif
+    
 private:
     
     using Filter = juce::dsp::LinkwitzRileyFilter<float>;
@@ -108,10 +168,62 @@ private:
     
     std::array<juce::AudioBuffer<float>, 3> filterBuffers;
     
+    //the cell being gathered, see subBlockSize. the samples not yet gathered are still the
+    //last cell's processed output, waiting to be handed back.
+    juce::AudioBuffer<float> cellBuffer;
+    int cellFill {0};
+    
+    //the history gathered since the last push to gainReductionHistoryFifo
+    GainReductionHistoryBlock pendingHistoryBlock;
+    
     juce::dsp::Gain<float> inputGain, outputGain;
     juce::AudioParameterFloat* inputGainParam {nullptr};
     juce::AudioParameterFloat* outputGainParam {nullptr};
     
+    juce::AudioParameterBool* truePeakLimiterParam {nullptr};
+    juce::AudioParameterFloat* truePeakCeilingParam {nullptr};
+    
+    //every parameter by Params::Names, for saving and loading the state
+    ParameterState::Parameters parametersByName {};
+    
+    juce::AudioParameterFloat* morphParam {nullptr};
+    
+    //the host's programs. a program change happens inside a write on presetApply.
+    PresetBank presetBank;
+    int currentProgram {0};
+    SeqLock presetApply;
+    
+    /**
+     every parameter the audio thread uses, read in one go at the start of a block
+     */
+    struct Settings
+    {
+        std::array<CompressorBand::Settings, 3> bands;
+        float lowMidCrossoverHz {0.f};
+        float midHighCrossoverHz {0.f};
+        float inputGainDb {0.f};
+        float outputGainDb {0.f};
+        bool truePeakLimiter {false};
+        float truePeakCeilingDb {0.f};
+        float morph {0.f}; //0 to 1
+    };
+    
+    Settings readSettings() const;
+    
+    /**
+     the parameters as read at the start of the block, with the morphed ones taken 'amount' of
+     the way from there to the snapshots at 'position'
+     */
+    Settings getMorphedSettings(float position, float amount) const;
+    void applySettings(const Settings& settings);
+    
+    Settings liveSettings;
+    bool morphing {false};
+    juce::SmoothedValue<float> morphPosition;
+    
+    //0 for the knobs' settings, 1 for the morph's. ramps when the snapshots are stored or cleared.
+    juce::SmoothedValue<float> morphAmount;
+    
     template<typename T, typename U>
     void applyGain(T& buffer, U& gain)
     {
@@ -120,8 +232,20 @@ private:
         gain.process(ctx);
     }
     
+    //editorState as getStateInformation writes it. the message thread keeps it up to date as
+    //editorState changes, setStateInformation replaces it and hands it to the message thread.
+    juce::CriticalSection savedEditorStateLock;
+    juce::MemoryBlock savedEditorState;
+    
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void handleAsyncUpdate() override;
+    void saveEditorState();
+    void applySavedEditorState();
+    
     void updateState();
     void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    void sumBands(juce::AudioBuffer<float>& buffer);
+    void processSubBlock(juce::AudioBuffer<float>& buffer);
     
     juce::dsp::Oscillator<float> osc;
     juce::dsp::Gain<float> gain;
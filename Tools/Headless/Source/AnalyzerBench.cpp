@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    AnalyzerBench.cpp
+    Created: 20 Oct 2026 11:20:41am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "AnalyzerBench.h"
+#include "ProcessorHost.h"
+#include "../../../Source/GUI/SpectrumAnalyzer.h"
+#include "../../../Source/GUI/AnalyzerSettings.h"
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int framesPerSecond = 60;
+
+//how long a resolution change may take to be built on the analyzer's background thread
+constexpr int resolutionTimeoutMs = 5000;
+
+struct Config
+{
+    int width;
+    int height;
+    float scale;
+    int resolution; //AnalyzerSettings::Resolution choice index
+};
+
+/**
+ per frame milliseconds for one stage
+ */
+struct StageStats
+{
+    void add(double ms)
+    {
+        total += ms;
+        worst = juce::jmax(worst, ms);
+        ++count;
+    }
+    
+    juce::var toVar() const
+    {
+        auto* stats = new juce::DynamicObject();
+        stats->setProperty("meanMs", count > 0 ? total / count : 0.0);
+        stats->setProperty("worstMs", worst);
+        return juce::var(stats);
+    }
+    
+    double total {0.0};
+    double worst {0.0};
+    int count {0};
+};
+
+double ticksToMs(juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+}
+
+juce::var run(const Config& config, int numFrames)
+{
+    using namespace juce;
+    
+    ProcessorHost host(2, sampleRate, blockSize);
+    if( host.getError().isNotEmpty() )
+        ConsoleApplication::fail(host.getError());
+    
+    auto& processor = host.processor;
+    AnalyzerSettings::set(processor.editorState, AnalyzerSettings::Resolution, config.resolution);
+    
+    SpectrumAnalyzer analyzer(processor);
+    analyzer.setBounds(0, 0, config.width, config.height);
+    
+    //one frame's worth of pink-ish noise, fed straight into the analyzer fifos like processBlock would
+    const auto samplesPerFrame = int(sampleRate / framesPerSecond);
+    AudioBuffer<float> audio(2, samplesPerFrame);
+    Random random(0x5eed);
+    float state = 0.f;
+    
+    auto fillFrame = [&]()
+    {
+        for( int i = 0; i < samplesPerFrame; ++i )
+        {
+            state = 0.97f * state + 0.03f * (random.nextFloat() * 2.f - 1.f);
+            audio.setSample(0, i, state * 4.f);
+            audio.setSample(1, i, state * 2.f);
+        }
+    };
+    
+    std::array<GainReductionTelemetry::Reading, 3> gainReduction {};
+    
+    //the software renderer, at the physical size a display with this scale factor would give it
+    Image image(Image::RGB,
+                roundToInt(config.width * config.scale),
+                roundToInt(config.height * config.scale),
+                true,
+                SoftwareImageType());
+    
+    PathProducer::StageTimes stageTimes;
+    analyzer.setStageTimes(&stageTimes);
+    
+    StageStats fifo, fft, path, paint, frame;
+    
+    auto runFrame = [&](bool record)
+    {
+        fillFrame();
+        processor.leftChannelFifo.update(audio);
+        processor.rightChannelFifo.update(audio);
+        
+        //moves the gain reduction overlay so it's drawn like a busy session would draw it
+        for( auto& reading : gainReduction )
+        {
+            reading.peakDb = -12.f * random.nextFloat();
+            reading.averageDb = reading.peakDb * 0.5f;
+        }
+        
+        stageTimes = {};
+        auto frameStart = Time::getHighResolutionTicks();
+        
+        analyzer.update(gainReduction);
+        
+        auto paintStart = Time::getHighResolutionTicks();
+        {
+            Graphics g(image);
+            g.addTransform(AffineTransform::scale(config.scale));
+            analyzer.paint(g);
+        }
+        auto paintEnd = Time::getHighResolutionTicks();
+        
+        if( record )
+        {
+            fifo.add(ticksToMs(stageTimes.fifoTicks));
+            fft.add(ticksToMs(stageTimes.fftTicks));
+            path.add(ticksToMs(stageTimes.pathTicks));
+            paint.add(ticksToMs(paintEnd - paintStart));
+            frame.add(ticksToMs(paintEnd - frameStart));
+        }
+    };
+    
+    //the resolution change is built on the analyzer's background thread and picked up by a later update()
+    auto waitStart = Time::getMillisecondCounter();
+    
+    while( !analyzer.isResolutionReady() )
+    {
+        if( Time::getMillisecondCounter() - waitStart > (uint32)resolutionTimeoutMs )
+            ConsoleApplication::fail("the analyzer didn't switch to the " + String(AnalyzerSettings::resolutionNames[(size_t)config.resolution]) + " resolution");
+        
+        runFrame(false);
+        Thread::sleep(1);
+    }
+    
+    //then a second of frames builds the cached layers and fills the new FFT's buffers
+    for( int i = 0; i < framesPerSecond; ++i )
+        runFrame(false);
+    
+    for( int i = 0; i < numFrames; ++i )
+        runFrame(true);
+    
+    analyzer.setStageTimes(nullptr);
+    
+    auto* result = new DynamicObject();
+    result->setProperty("width", config.width);
+    result->setProperty("height", config.height);
+    result->setProperty("scale", config.scale);
+    result->setProperty("resolution", AnalyzerSettings::resolutionNames[(size_t)config.resolution]);
+    //what the analyzer actually timed, not just what was asked for
+    result->setProperty("fftOrder", (int)analyzer.getFFTOrder());
+    result->setProperty("multiResolution", analyzer.isMultiResolution());
+    result->setProperty("frames", numFrames);
+    result->setProperty("fifo", fifo.toVar());
+    result->setProperty("fft", fft.toVar());
+    result->setProperty("path", path.toVar());
+    result->setProperty("paint", paint.toVar());
+    result->setProperty("frame", frame.toVar());
+    return var(result);
+}
+}
+
+juce::ConsoleApplication::Command AnalyzerBench::makeCommand()
+{
+    return
+    {
+        "bench-ui",
+        "bench-ui [--out <file.json>] [--frames <n>] [--quick]",
+        "Times the spectrum analyzer's frame stages and writes them as JSON.",
+        "Feeds 48 kHz noise into the analyzer fifos at 60 frames a second, runs its update and paints it into "
+        "an offscreen image with the software renderer. Reports the mean and worst milliseconds per frame for "
+        "draining the fifos, the FFT and smoothing, building the path and painting, at several sizes, scale "
+        "factors and FFT resolutions. --frames sets how many frames each configuration is timed over "
+        "(default 600). --quick runs a small subset.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            auto numFrames = args.containsOption("--frames") ? args.getValueForOption("--frames").getIntValue() : 600;
+            numFrames = jlimit(1, 100000, numFrames);
+            
+            std::vector<Point<int>> sizes { { 400, 200 }, { 600, 300 }, { 1200, 600 }, { 1920, 960 } };
+            std::vector<float> scales { 1.f, 1.5f, 2.f };
+            
+            //2048, 4096, 8192 and multi-resolution
+            std::vector<int> resolutionIndices { 0, 1, 2, 3 };
+            
+            if( args.containsOption("--quick") )
+            {
+                sizes = { { 600, 300 } };
+                scales = { 1.f, 2.f };
+                resolutionIndices = { 0 };
+            }
+            
+            Array<var> results;
+            
+            for( auto resolution : resolutionIndices )
+            {
+                for( auto size : sizes )
+                {
+                    for( auto scale : scales )
+                    {
+                        results.add(run({ size.x, size.y, scale, resolution }, numFrames));
+                        std::cerr << "." << std::flush;
+                    }
+                }
+            }
+            
+            std::cerr << std::endl;
+            
+            auto* report = new DynamicObject();
+            report->setProperty("benchmark", "analyzer");
+            report->setProperty("renderer", "software");
+            report->setProperty("sampleRate", sampleRate);
+            report->setProperty("framesPerSecond", framesPerSecond);
+            report->setProperty("results", results);
+            
+            writeReport(var(report), args);
+        }
+    };
+}
@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    AnalyzerBench.h
+    Created: 20 Oct 2026 11:20:41am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace AnalyzerBench
+{
+/**
+ drives the SpectrumAnalyzer without a window: feeds its fifos, updates it and paints it into an
+ offscreen software image, timing each stage of a frame. writes the results as JSON.
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
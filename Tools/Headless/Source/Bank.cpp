@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    Bank.cpp
+    Created: 21 Oct 2026 4:31:55pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "Bank.h"
+#include "ProcessorHost.h"
+#include "../../../Source/DSP/PresetBank.h"
+
+namespace
+{
+/**
+ loads 'state' into a processor and reads every parameter back, so any format the plugin
+ accepts can go into a bank
+ */
+PresetBank::Preset makePreset(const juce::String& name, const juce::MemoryBlock& state)
+{
+    ProcessorHost host(2, 48000.0, 512, state);
+    if( host.getError().isNotEmpty() )
+        juce::ConsoleApplication::fail(host.getError());
+    
+    PresetBank::Preset preset;
+    preset.name = name;
+    
+    for( int i = 0; i < Params::NumParams; ++i )
+    {
+        auto& param = Params::getParam(host.processor, Params::Names(i));
+        preset.values[(size_t)i] = param.convertFrom0to1(param.getValue());
+    }
+    
+    return preset;
+}
+
+void list(const juce::File& file)
+{
+    PresetBank bank;
+    auto result = bank.open(file);
+    if( result.failed() )
+        juce::ConsoleApplication::fail(result.getErrorMessage());
+    
+    for( int i = 0; i < bank.getNumPresets(); ++i )
+        std::cout << i << ": " << bank.getName(i) << std::endl;
+}
+}
+
+juce::ConsoleApplication::Command Bank::makeCommand()
+{
+    return
+    {
+        "bank",
+        "bank --out <file.mbcbank> <states...> | bank --list <file.mbcbank>",
+        "Builds a preset bank the plugin shows as its programs.",
+        "Each state file becomes one preset, named after the file and in the order given. A state can be a "
+        "saved plugin state or the parameter tree as XML. Names longer than 31 bytes are cut short. Instances "
+        "load the bank in $MULTIBAND_PRESET_BANK, or Presets.mbcbank in the user's application data folder "
+        "under MultibandCompressor. --list prints the presets in a bank.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            if( args.containsOption("--list") )
+            {
+                list(args.getExistingFileForOption("--list"));
+                return;
+            }
+            
+            auto out = args.getFileForOption("--out");
+            
+            std::vector<PresetBank::Preset> presets;
+            
+            //every plain argument after the command name is a state file
+            for( int i = 1; i < args.size(); ++i )
+            {
+                const auto& arg = args[i];
+                if( arg.isOption() )
+                {
+                    //skip the option's value too
+                    if( !arg.text.contains("=") )
+                        ++i;
+                    continue;
+                }
+                
+                auto file = arg.resolveAsExistingFile();
+                
+                MemoryBlock state;
+                auto result = loadStateFile(file, state);
+                if( result.failed() )
+                    ConsoleApplication::fail(result.getErrorMessage());
+                
+                presets.push_back(makePreset(file.getFileNameWithoutExtension(), state));
+            }
+            
+            if( presets.empty() )
+                ConsoleApplication::fail("no state files given");
+            
+            auto result = PresetBank::write(out, presets);
+            if( result.failed() )
+                ConsoleApplication::fail(result.getErrorMessage());
+            
+            std::cout << "wrote " << presets.size() << " presets to " << out.getFullPathName() << std::endl;
+        }
+    };
+}
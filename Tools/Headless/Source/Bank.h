@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    Bank.h
+    Created: 21 Oct 2026 4:31:55pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Bank
+{
+/**
+ builds a preset bank from saved states, or lists the presets in one
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    Bench.cpp
+    Created: 20 Oct 2026 10:02:15am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "Bench.h"
+#include "ProcessorHost.h"
+#include "../../../Source/DSP/CycleCounter.h"
+
+namespace
+{
+enum class BandState
+{
+    Active,
+    Bypassed,
+    Soloed
+};
+
+const char* getName(BandState state)
+{
+    switch( state )
+    {
+        case BandState::Active: return "active";
+        case BandState::Bypassed: return "bypassed";
+        case BandState::Soloed: return "soloed";
+    }
+    
+    return "";
+}
+
+struct Config
+{
+    int blockSize;
+    double sampleRate;
+    int numChannels;
+    BandState bands;
+};
+
+struct Timing
+{
+    double nsPerSample;
+    double cyclesPerSample;
+    
+    //per call stage timings, only with MULTIBAND_STAGE_TIMING
+    juce::var stages;
+};
+
+void applyBandState(ProcessorHost& host, BandState state)
+{
+    using namespace Params;
+    
+    //thresholds low enough that every band is compressing the test signal
+    for( auto name : { Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band } )
+        host.setParameter(name, -30.f);
+    
+    auto bypassed = state == BandState::Bypassed ? 1.f : 0.f;
+    for( auto name : { Bypassed_Low_Band, Bypassed_Mid_Band, Bypassed_High_Band } )
+        host.setParameter(name, bypassed);
+    
+    host.setParameter(Solo_Mid_Band, state == BandState::Soloed ? 1.f : 0.f);
+}
+
+/**
+ runs the config 'repeats' times over 'seconds' of noise and keeps the fastest run,
+ which is the one least disturbed by everything else on the machine
+ */
+Timing run(const Config& config, double seconds, int repeats)
+{
+    ProcessorHost host(config.numChannels, config.sampleRate, config.blockSize);
+    if( host.getError().isNotEmpty() )
+        juce::ConsoleApplication::fail(host.getError());
+    applyBandState(host, config.bands);
+    
+    auto numBlocks = juce::jmax(1, int(seconds * config.sampleRate / config.blockSize));
+    
+    //the same noise every run, at a level the compressors react to
+    juce::AudioBuffer<float> source(config.numChannels, numBlocks * config.blockSize);
+    juce::Random random(0x5eed);
+    for( int ch = 0; ch < source.getNumChannels(); ++ch )
+    {
+        auto* samples = source.getWritePointer(ch);
+        for( int i = 0; i < source.getNumSamples(); ++i )
+            samples[i] = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+    }
+    
+    juce::AudioBuffer<float> block(config.numChannels, config.blockSize);
+    
+    auto processAll = [&]()
+    {
+        for( int b = 0; b < numBlocks; ++b )
+        {
+            for( int ch = 0; ch < config.numChannels; ++ch )
+                block.copyFrom(ch, 0, source, ch, b * config.blockSize, config.blockSize);
+            
+            host.process(block);
+        }
+    };
+    
+    //warm up the caches, the branch predictors and the envelopes
+    processAll();
+    
+   #if MULTIBAND_STAGE_TIMING
+    host.processor.stageProfiler.reset();
+   #endif
+    
+    Timing best { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), {} };
+    const auto numSamples = double(numBlocks) * config.blockSize;
+    
+    for( int r = 0; r < repeats; ++r )
+    {
+        auto startTicks = juce::Time::getHighResolutionTicks();
+        auto startCycles = CycleCounter::now();
+        
+        processAll();
+        
+        auto cycles = double(CycleCounter::now() - startCycles);
+        auto ns = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e9;
+        
+        best.nsPerSample = juce::jmin(best.nsPerSample, ns / numSamples);
+        best.cyclesPerSample = juce::jmin(best.cyclesPerSample, cycles / numSamples);
+    }
+    
+   #if MULTIBAND_STAGE_TIMING
+    auto* stages = new juce::DynamicObject();
+    const auto& profiler = host.processor.stageProfiler;
+    
+    for( int stage = 0; stage < StageProfiler::NumStages; ++stage )
+    {
+        auto summary = profiler.getSummary(StageProfiler::Stage(stage));
+        
+        auto* stats = new juce::DynamicObject();
+        stats->setProperty("min", summary.min);
+        stats->setProperty("mean", summary.mean);
+        stats->setProperty("p99", summary.p99);
+        stats->setProperty("max", summary.max);
+        stages->setProperty(StageProfiler::getStageName(StageProfiler::Stage(stage)), juce::var(stats));
+    }
+    
+    best.stages = juce::var(stages);
+   #endif
+    
+    return best;
+}
+}
+
+juce::ConsoleApplication::Command Bench::makeCommand()
+{
+    return
+    {
+        "bench",
+        "bench [--out <file.json>] [--seconds <s>] [--repeats <n>] [--quick]",
+        "Times processBlock and writes ns/sample and cycles/sample as JSON.",
+        "Sweeps block sizes 16-4096, sample rates 44.1-192 kHz, mono and stereo, and the bands active, bypassed "
+        "or soloed. Each configuration processes --seconds of noise (default 2) --repeats times (default 3) after a "
+        "warm up pass, and the fastest pass is reported. --quick runs a small subset for a fast sanity check. "
+        "Results go to stdout unless --out is given. Built with MULTIBAND_STAGE_TIMING=1 each result also has "
+        "the min, mean, p99 and max cycles per call of every processBlock stage, over all the timed passes. The stages "
+        "from input gain to the limiter run once per 64 sample sub-block, the others once per block.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 2.0;
+            auto repeats = args.containsOption("--repeats") ? args.getValueForOption("--repeats").getIntValue() : 3;
+            seconds = jlimit(0.05, 60.0, seconds);
+            repeats = jlimit(1, 100, repeats);
+            
+            std::vector<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+            std::vector<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+            std::vector<int> channelCounts { 1, 2 };
+            std::vector<BandState> bandStates { BandState::Active, BandState::Bypassed, BandState::Soloed };
+            
+            if( args.containsOption("--quick") )
+            {
+                blockSizes = { 64, 512 };
+                sampleRates = { 48000.0 };
+                channelCounts = { 2 };
+            }
+            
+            Array<var> results;
+            
+            for( auto sampleRate : sampleRates )
+            {
+                for( auto numChannels : channelCounts )
+                {
+                    for( auto bands : bandStates )
+                    {
+                        for( auto blockSize : blockSizes )
+                        {
+                            Config config { blockSize, sampleRate, numChannels, bands };
+                            auto timing = run(config, seconds, repeats);
+                            
+                            auto* result = new DynamicObject();
+                            result->setProperty("blockSize", blockSize);
+                            result->setProperty("sampleRate", sampleRate);
+                            result->setProperty("channels", numChannels);
+                            result->setProperty("bands", getName(bands));
+                            result->setProperty("nsPerSample", timing.nsPerSample);
+                            result->setProperty("cyclesPerSample", timing.cyclesPerSample);
+                            
+                            //how many of these would fit on one core in real time
+                            result->setProperty("realtimeFactor", 1.0e9 / (timing.nsPerSample * sampleRate));
+                            
+                            if( !timing.stages.isVoid() )
+                                result->setProperty("stageCyclesPerCall", timing.stages);
+                            results.add(var(result));
+                            
+                            std::cerr << "." << std::flush;
+                        }
+                    }
+                }
+            }
+            
+            std::cerr << std::endl;
+            
+            auto* machine = new DynamicObject();
+            machine->setProperty("cycleCounter", CycleCounter::getUnit());
+            
+            auto* report = new DynamicObject();
+            report->setProperty("benchmark", "processBlock");
+            report->setProperty("machine", var(machine));
+            report->setProperty("secondsPerRun", seconds);
+            report->setProperty("repeats", repeats);
+            report->setProperty("results", results);
+            
+            writeReport(var(report), args);
+        }
+    };
+}
@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    Bench.h
+    Created: 20 Oct 2026 10:02:15am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Bench
+{
+/**
+ times processBlock across block sizes, sample rates, channel counts and band states,
+ and writes the results as JSON
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
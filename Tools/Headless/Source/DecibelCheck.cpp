@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    DecibelCheck.cpp
+    Created: 21 Oct 2026 4:05:37pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "DecibelCheck.h"
+#include "ProcessorHost.h"
+#include "../../../Source/GUI/FFTDataGenerator.h"
+
+namespace
+{
+using Generator = FFTDataGenerator<std::vector<float>>;
+
+//what the analyzer passes at order8192
+constexpr int numBins = 4096;
+constexpr float negativeInfinity = -72.f;
+const float normalisationDb = -juce::Decibels::gainToDecibels(float(numBins));
+
+float fromBits(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint32_t toBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+struct Accuracy
+{
+    double maxErrorDb {0.0};
+    float worstMagnitude {0.f};
+    int numChecked {0};
+    int numWrongSpecialValues {0};
+};
+
+/**
+ every 'stride'th float from 2^-30 to 2^30, well past both ends of what an FFT bin holds,
+ plus 0, denormals, infinities and NaN which all have to come out as negativeInfinity
+ */
+Accuracy checkAccuracy(uint32_t stride)
+{
+    Accuracy accuracy;
+    std::vector<float> magnitudes, decibels;
+    magnitudes.reserve(numBins);
+    
+    auto checkBatch = [&]()
+    {
+        decibels = magnitudes;
+        Generator::convertMagnitudesToDecibels(decibels.data(), (int)decibels.size(), normalisationDb, -1000.f);
+        
+        for( size_t i = 0; i < magnitudes.size(); ++i )
+        {
+            auto expected = 20.0 * std::log10(double(magnitudes[i])) + normalisationDb;
+            auto error = std::abs(double(decibels[i]) - expected);
+            
+            if( error > accuracy.maxErrorDb )
+            {
+                accuracy.maxErrorDb = error;
+                accuracy.worstMagnitude = magnitudes[i];
+            }
+        }
+        
+        accuracy.numChecked += (int)magnitudes.size();
+        magnitudes.clear();
+    };
+    
+    const auto first = toBits(std::ldexp(1.f, -30));
+    const auto last = toBits(std::ldexp(1.f, 30));
+    
+    for( auto bits = first; bits <= last; bits += stride )
+    {
+        magnitudes.push_back(fromBits(bits));
+        
+        if( (int)magnitudes.size() == numBins )
+            checkBatch();
+    }
+    
+    checkBatch();
+    
+    std::vector<float> special
+    {
+        0.f,
+        -0.f,
+        std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+    
+    Generator::convertMagnitudesToDecibels(special.data(), (int)special.size(), normalisationDb, negativeInfinity);
+    
+    for( auto decibels : special )
+    {
+        if( decibels != negativeInfinity )
+            ++accuracy.numWrongSpecialValues;
+    }
+    
+    return accuracy;
+}
+
+/**
+ the per bin normalize, sanitize and convert loop FFTDataGenerator used before
+ convertMagnitudesToDecibels
+ */
+void gainToDecibelsLoop(float* data, int numBins, float negativeInfinity)
+{
+    for( int i = 0; i < numBins; ++i )
+    {
+        auto v = data[i];
+        if( !std::isinf(v) && !std::isnan(v) )
+            v /= float(numBins);
+        else
+            v = 0.f;
+        
+        data[i] = juce::Decibels::gainToDecibels(v, negativeInfinity);
+    }
+}
+
+/**
+ the fastest of 'repeats' runs, in nanoseconds per bin
+ */
+template<typename Convert>
+double timeConversion(Convert&& convert, const std::vector<float>& spectrum, int passesPerRun, int repeats)
+{
+    std::vector<float> data(spectrum.size());
+    auto best = std::numeric_limits<double>::max();
+    
+    //keeps the results alive so the optimiser can't drop the work
+    volatile float sink = 0.f;
+    
+    for( int r = 0; r < repeats; ++r )
+    {
+        auto ticks = juce::int64(0);
+        
+        for( int pass = 0; pass < passesPerRun; ++pass )
+        {
+            std::copy(spectrum.begin(), spectrum.end(), data.begin());
+            
+            auto start = juce::Time::getHighResolutionTicks();
+            convert(data.data(), (int)data.size());
+            ticks += juce::Time::getHighResolutionTicks() - start;
+            
+            sink = sink + data[(size_t)pass % data.size()];
+        }
+        
+        auto ns = juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9;
+        best = juce::jmin(best, ns / (double(passesPerRun) * spectrum.size()));
+    }
+    
+    return best;
+}
+}
+
+juce::ConsoleApplication::Command DecibelCheck::makeCommand()
+{
+    return
+    {
+        "decibels",
+        "decibels [--out <file.json>] [--stride <n>] [--repeats <n>]",
+        "Checks the analyzer's fast magnitude-to-dB conversion against std::log10 and times it.",
+        "Converts every --stride'th float (default 61) between 2^-30 and 2^30 and fails if any result is further "
+        "than FFTDataGenerator::maxDecibelError from 20 * log10, or if 0, denormals, infinities or NaN don't come "
+        "out as the floor. Then times it against the per bin juce::Decibels::gainToDecibels loop it replaced, on "
+        "a " + juce::String(numBins) + " bin spectrum, keeping the fastest of --repeats runs (default 5). "
+        "Writes the error and the ns/bin of both to stdout, or to --out.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            auto stride = args.containsOption("--stride") ? args.getValueForOption("--stride").getIntValue() : 61;
+            auto repeats = args.containsOption("--repeats") ? args.getValueForOption("--repeats").getIntValue() : 5;
+            stride = jlimit(1, 1 << 20, stride);
+            repeats = jlimit(1, 100, repeats);
+            
+            auto accuracy = checkAccuracy((uint32_t)stride);
+            
+            //a spectrum shaped like the analyzer's input, falling 3 dB an octave from the top of the range down
+            std::vector<float> spectrum((size_t)numBins);
+            Random random(0x5eed);
+            for( size_t i = 0; i < spectrum.size(); ++i )
+                spectrum[i] = float(numBins) * random.nextFloat() / std::sqrt(float(i + 1));
+            
+            auto fastNs = timeConversion([](float* data, int size)
+                                         {
+                                             Generator::convertMagnitudesToDecibels(data, size, normalisationDb, negativeInfinity);
+                                         },
+                                         spectrum, 2000, repeats);
+            
+            auto oldNs = timeConversion([](float* data, int size)
+                                        {
+                                            gainToDecibelsLoop(data, size, negativeInfinity);
+                                        },
+                                        spectrum, 2000, repeats);
+            
+            auto* report = new DynamicObject();
+            report->setProperty("benchmark", "decibels");
+            report->setProperty("checked", accuracy.numChecked);
+            report->setProperty("maxErrorDb", accuracy.maxErrorDb);
+            report->setProperty("worstMagnitude", accuracy.worstMagnitude);
+            report->setProperty("boundDb", Generator::maxDecibelError);
+            report->setProperty("bins", numBins);
+            report->setProperty("nsPerBin", fastNs);
+            report->setProperty("gainToDecibelsNsPerBin", oldNs);
+            report->setProperty("speedup", oldNs / fastNs);
+            
+            writeReport(var(report), args);
+            
+            if( accuracy.numWrongSpecialValues > 0 )
+                ConsoleApplication::fail(String(accuracy.numWrongSpecialValues) + " of 0, denormal, infinite and NaN "
+                                         "magnitudes didn't convert to the floor");
+            
+            if( accuracy.maxErrorDb > Generator::maxDecibelError )
+                ConsoleApplication::fail("max error " + String(accuracy.maxErrorDb, 5) + " dB at magnitude "
+                                         + String(accuracy.worstMagnitude) + " is over the "
+                                         + String(Generator::maxDecibelError, 4) + " dB bound");
+        }
+    };
+}
@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    DecibelCheck.h
+    Created: 21 Oct 2026 4:05:37pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace DecibelCheck
+{
+/**
+ checks the analyzer's approximate magnitude-to-dB conversion against std::log10 and times it
+ against the juce::Decibels::gainToDecibels loop it replaced
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+    Fuzz.cpp
+    Created: 21 Oct 2026 11:02:47am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "Fuzz.h"
+#include "ProcessorHost.h"
+#include "RealtimeGuard.h"
+
+namespace
+{
+constexpr int maxHostBlockSize = 8192;
+constexpr int referenceBlockSize = MultibandCompressorAudioProcessor::subBlockSize;
+
+/**
+ noise whose level jumps every 100 ms, so the compressors and the limiter keep moving
+ */
+void makeSignal(juce::AudioBuffer<float>& buffer, double sampleRate, juce::Random& random)
+{
+    const auto segmentLength = int(sampleRate / 10);
+    
+    for( int start = 0; start < buffer.getNumSamples(); start += segmentLength )
+    {
+        auto level = juce::Decibels::decibelsToGain(random.nextFloat() * -48.f + 6.f);
+        auto numSamples = juce::jmin(segmentLength, buffer.getNumSamples() - start);
+        
+        for( int ch = 0; ch < buffer.getNumChannels(); ++ch )
+        {
+            auto* samples = buffer.getWritePointer(ch, start);
+            for( int i = 0; i < numSamples; ++i )
+                samples[i] = (random.nextFloat() * 2.f - 1.f) * level;
+        }
+    }
+}
+
+void setUp(ProcessorHost& host)
+{
+    using namespace Params;
+    
+    const std::pair<Names, float> parameters[]
+    {
+        { Threshold_Low_Band, -30.f }, { Threshold_Mid_Band, -24.f }, { Threshold_High_Band, -18.f },
+        { Attack_Low_Band, 5.f }, { Attack_Mid_Band, 5.f }, { Attack_High_Band, 5.f },
+        { Release_Low_Band, 50.f }, { Release_Mid_Band, 50.f }, { Release_High_Band, 50.f },
+        { Gain_in, 6.f }, { True_Peak_Limiter, 1.f }, { True_Peak_Ceiling, -1.f },
+    };
+    
+    for( const auto& [name, value] : parameters )
+        host.setParameter(name, value);
+}
+
+/**
+ a parameter change, or a snapshot store, made between blocks like a host or the editor would.
+ they land on the sub-block grid, so every run makes them at the same sample whatever its block sizes.
+ */
+struct Automation
+{
+    int sample;
+    Params::Names name;
+    float normalisedValue;
+    int snapshot; //stores this snapshot instead of changing 'name' when it's 0 or more
+};
+
+/**
+ random changes to the continuous parameters and the morph every 20 to 200 ms. snapshot A is stored a
+ third of the way through and B half way, so the second half morphs between settings that differ.
+ */
+std::vector<Automation> makeAutomation(int numSamples, double sampleRate, juce::Random& random)
+{
+    using namespace Params;
+    
+    const Names automated[]
+    {
+        Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band,
+        Attack_Low_Band, Attack_Mid_Band, Attack_High_Band,
+        Release_Low_Band, Release_Mid_Band, Release_High_Band,
+        Ratio_Low_Band, Ratio_Mid_Band, Ratio_High_Band,
+        Low_Mid_Crossover_Freq, Mid_High_Crossover_Freq,
+        Gain_in, Gain_out, True_Peak_Ceiling,
+    };
+    
+    auto onGrid = [](int sample) { return sample - sample % referenceBlockSize; };
+    
+    std::vector<Automation> automation;
+    automation.push_back({ onGrid(numSamples / 3), Morph, 0.f, 0 });
+    automation.push_back({ onGrid(numSamples / 2), Morph, 0.f, 1 });
+    
+    const auto minGap = int(sampleRate * 0.02), maxGap = int(sampleRate * 0.2);
+    for( int sample = onGrid(minGap); sample < numSamples; sample = onGrid(sample + minGap + random.nextInt(maxGap - minGap)) )
+    {
+        //the morph moves about as often as everything else put together
+        auto name = random.nextBool() ? Morph : automated[random.nextInt((int)std::size(automated))];
+        automation.push_back({ sample, name, random.nextFloat(), -1 });
+    }
+    
+    std::stable_sort(automation.begin(), automation.end(), [](const auto& a, const auto& b) { return a.sample < b.sample; });
+    return automation;
+}
+
+void apply(ProcessorHost& host, const Automation& change)
+{
+    if( change.snapshot >= 0 )
+        host.processor.storeSnapshot(change.snapshot);
+    else
+        Params::getParam(host.processor, change.name).setValueNotifyingHost(change.normalisedValue);
+}
+
+/**
+ picks the next host block size. mostly uniform over the whole range, with the extremes and
+ the sizes either side of a sub-block boundary over-represented.
+ */
+int nextBlockSize(juce::Random& random)
+{
+    switch( random.nextInt(8) )
+    {
+        case 0: return 1;
+        case 1: return maxHostBlockSize;
+        case 2: return referenceBlockSize - 1 + random.nextInt(3);
+        case 3: return 1 + random.nextInt(referenceBlockSize);
+        default: return 1 + random.nextInt(maxHostBlockSize);
+    }
+}
+
+/**
+ processes 'buffer' in place in blocks whose sizes come from 'getBlockSize', making each change in
+ 'automation' before the block that starts at its sample. a block that would run past a change is
+ cut short there, the way a host splits a block at an automation point. each block is a view of
+ 'buffer' so nothing is copied or allocated between blocks.
+ */
+template<typename BlockSizeSource>
+int render(ProcessorHost& host,
+           juce::AudioBuffer<float>& buffer,
+           const std::vector<Automation>& automation,
+           BlockSizeSource&& getBlockSize,
+           const char* context)
+{
+    int numBlocks = 0;
+    auto nextChange = automation.begin();
+    
+    RealtimeGuard::setContext(context);
+    
+    for( int start = 0; start < buffer.getNumSamples(); ++numBlocks )
+    {
+        for( ; nextChange != automation.end() && nextChange->sample <= start; ++nextChange )
+            apply(host, *nextChange);
+        
+        auto end = nextChange != automation.end() ? nextChange->sample : buffer.getNumSamples();
+        auto numSamples = juce::jmin(getBlockSize(), end - start);
+        
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, numSamples);
+        {
+            //only the processing is the audio thread, the changes come from the host's other threads
+            RealtimeGuard::ScopedArm audioThread;
+            host.process(block);
+        }
+        
+        start += numSamples;
+    }
+    
+    return numBlocks;
+}
+
+/**
+ returns the largest difference between the two, or infinity if 'output' isn't finite
+ */
+float compare(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference)
+{
+    auto maxDifference = 0.f;
+    
+    for( int ch = 0; ch < output.getNumChannels(); ++ch )
+    {
+        auto* out = output.getReadPointer(ch);
+        auto* ref = reference.getReadPointer(ch);
+        
+        for( int i = 0; i < output.getNumSamples(); ++i )
+        {
+            if( !std::isfinite(out[i]) )
+                return std::numeric_limits<float>::infinity();
+            
+            maxDifference = juce::jmax(maxDifference, std::abs(out[i] - ref[i]));
+        }
+    }
+    
+    return maxDifference;
+}
+}
+
+juce::ConsoleApplication::Command Fuzz::makeCommand()
+{
+    return
+    {
+        "fuzz",
+        "fuzz [--runs <n>] [--seconds <s>] [--seed <n>] [--tolerance <x>]",
+        "Checks the output doesn't depend on the host's block size.",
+        "Renders seeded noise with the compressors and limiter working, once in fixed 64 sample blocks "
+        "as the reference and then --runs times (default 20) with random block sizes from 1 to 8192, "
+        "including both extremes and sizes around 64. Every render automates the same random changes to "
+        "the continuous parameters and the morph, and stores the A and B snapshots part way through so "
+        "the morph takes over. Each run has to be finite and within --tolerance "
+        "(default 1e-5) of the reference. Where rtcheck is supported the runs are also checked for "
+        "calls that aren't real-time safe. --seconds sets the length of the audio (default 4), --seed "
+        "makes a failing run repeatable. Exits with status 1 on the first failure.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            auto runs = args.containsOption("--runs") ? args.getValueForOption("--runs").getIntValue() : 20;
+            runs = jmax(1, runs);
+            
+            auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 4.0;
+            seconds = jlimit(0.1, 600.0, seconds);
+            
+            auto tolerance = args.containsOption("--tolerance") ? args.getValueForOption("--tolerance").getFloatValue() : 1.0e-5f;
+            
+            Random random(getSeed(args));
+            
+            if( !RealtimeGuard::isSupported() )
+                std::cout << "real-time safety isn't checked on this platform" << std::endl;
+            
+            for( auto sampleRate : { 44100.0, 96000.0 } )
+            {
+                for( auto numChannels : { 1, 2 } )
+                {
+                    AudioBuffer<float> input(numChannels, int(seconds * sampleRate));
+                    makeSignal(input, sampleRate, random);
+                    
+                    const auto automation = makeAutomation(input.getNumSamples(), sampleRate, random);
+                    
+                    //prepared for the reference's block size, so the prepared size is varied too
+                    AudioBuffer<float> reference;
+                    reference.makeCopyOf(input);
+                    {
+                        ProcessorHost host(numChannels, sampleRate, referenceBlockSize);
+                        if( host.getError().isNotEmpty() )
+                            ConsoleApplication::fail(host.getError());
+                        
+                        setUp(host);
+                        render(host, reference, automation, [] { return referenceBlockSize; }, "rendering the reference");
+                    }
+                    
+                    AudioBuffer<float> output(numChannels, input.getNumSamples());
+                    auto worst = 0.f;
+                    
+                    for( int run = 0; run < runs; ++run )
+                    {
+                        ProcessorHost host(numChannels, sampleRate, maxHostBlockSize);
+                        setUp(host);
+                        
+                        output.makeCopyOf(input, true);
+                        auto numBlocks = render(host, output, automation, [&random] { return nextBlockSize(random); }, "processing random block sizes");
+                        
+                        auto difference = compare(output, reference);
+                        if( !(difference <= tolerance) )
+                        {
+                            ConsoleApplication::fail(String(numChannels) + " ch, " + String(sampleRate) + " Hz, run "
+                                                     + String(run) + " (" + String(numBlocks) + " blocks): output differs from "
+                                                     + "the reference by " + String(difference));
+                        }
+                        
+                        worst = jmax(worst, difference);
+                    }
+                    
+                    std::cout << numChannels << " ch, " << sampleRate << " Hz: " << runs
+                              << " runs ok, largest difference " << worst << std::endl;
+                }
+            }
+            
+            std::cout << "output is independent of the host block size" << std::endl;
+        }
+    };
+}
@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    Fuzz.h
+    Created: 21 Oct 2026 11:02:47am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Fuzz
+{
+/**
+ processes the same audio with random host block sizes from 1 to 8192 samples and checks the
+ output matches processing it in fixed 64 sample blocks
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
@@ -0,0 +1,466 @@
+/*
+  ==============================================================================
+
+    Golden.cpp
+    Created: 21 Oct 2026 9:14:02am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "Golden.h"
+#include "ProcessorHost.h"
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int numChannels = 2;
+constexpr int signalLength = 2 * 48000;
+
+//==============================================================================
+/**
+ exponential sweep from 20 Hz to 20 kHz at -6 dBFS
+ */
+void makeSweep(juce::AudioBuffer<float>& buffer)
+{
+    const auto startHz = 20.0, endHz = 20000.0;
+    const auto seconds = signalLength / sampleRate;
+    const auto k = std::log(endHz / startHz);
+    
+    for( int i = 0; i < signalLength; ++i )
+    {
+        auto t = i / sampleRate;
+        auto phase = juce::MathConstants<double>::twoPi * startHz * seconds / k * (std::exp(t / seconds * k) - 1.0);
+        auto sample = float(0.5 * std::sin(phase));
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            buffer.setSample(ch, i, sample);
+    }
+}
+
+/**
+ Paul Kellet's pink filter on seeded white noise, different on each channel
+ */
+void makePinkNoise(juce::AudioBuffer<float>& buffer)
+{
+    juce::Random random(0x91c4);
+    
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        float b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0;
+        
+        for( int i = 0; i < signalLength; ++i )
+        {
+            auto white = random.nextFloat() * 2.f - 1.f;
+            b0 = 0.99886f * b0 + white * 0.0555179f;
+            b1 = 0.99332f * b1 + white * 0.0750759f;
+            b2 = 0.96900f * b2 + white * 0.1538520f;
+            b3 = 0.86650f * b3 + white * 0.3104856f;
+            b4 = 0.55000f * b4 + white * 0.5329522f;
+            b5 = -0.7616f * b5 - white * 0.0168980f;
+            auto pink = b0 + b1 + b2 + b3 + b4 + b5 + b6 + white * 0.5362f;
+            b6 = white * 0.115926f;
+            
+            buffer.setSample(ch, i, pink * 0.11f);
+        }
+    }
+}
+
+/**
+ full and half scale impulses, a quarter of a second apart
+ */
+void makeImpulses(juce::AudioBuffer<float>& buffer)
+{
+    buffer.clear();
+    
+    const auto spacing = int(sampleRate / 4);
+    for( int i = spacing / 2, n = 0; i < signalLength; i += spacing, ++n )
+    {
+        for( int ch = 0; ch < numChannels; ++ch )
+            buffer.setSample(ch, i, n % 2 == 0 ? 1.f : 0.5f);
+    }
+}
+
+/**
+ kick-like decaying sines and snare-like noise bursts with 1 ms attacks, over a quiet bed
+ */
+void makeTransients(juce::AudioBuffer<float>& buffer)
+{
+    juce::Random random(0x7a11);
+    
+    const auto attack = int(sampleRate * 0.001);
+    const auto hitSpacing = int(sampleRate / 4);
+    
+    for( int i = 0; i < signalLength; ++i )
+    {
+        auto hit = i / hitSpacing;
+        auto sinceHit = i % hitSpacing;
+        auto t = sinceHit / sampleRate;
+        
+        auto envelope = float(sinceHit < attack ? double(sinceHit) / attack : std::exp(-t * 18.0));
+        auto kickPitch = 50.0 + 100.0 * std::exp(-t * 40.0);
+        auto kick = float(std::sin(juce::MathConstants<double>::twoPi * kickPitch * t));
+        
+        auto sample = hit % 2 == 0 ? 0.9f * envelope * kick
+                                   : 0.6f * envelope * (random.nextFloat() * 2.f - 1.f);
+        sample += 0.01f * (random.nextFloat() * 2.f - 1.f);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            buffer.setSample(ch, i, sample);
+    }
+}
+
+struct Signal
+{
+    const char* name;
+    void (*make)(juce::AudioBuffer<float>&);
+};
+
+const std::array<Signal, 4> signals
+{{
+    { "sweep", makeSweep },
+    { "pink", makePinkNoise },
+    { "impulses", makeImpulses },
+    { "transients", makeTransients },
+}};
+
+//==============================================================================
+/**
+ settings every signal is rendered with. the soloed cases isolate one band's crossover and compressor.
+ */
+struct Case
+{
+    const char* name;
+    std::vector<std::pair<Params::Names, float>> parameters;
+};
+
+std::vector<Case> makeCases()
+{
+    using namespace Params;
+    
+    std::vector<std::pair<Names, float>> compressing
+    {
+        { Threshold_Low_Band, -30.f }, { Threshold_Mid_Band, -24.f }, { Threshold_High_Band, -18.f },
+        { Attack_Low_Band, 20.f }, { Attack_Mid_Band, 10.f }, { Attack_High_Band, 5.f },
+        { Release_Low_Band, 200.f }, { Release_Mid_Band, 120.f }, { Release_High_Band, 60.f },
+    };
+    
+    auto with = [compressing](std::vector<std::pair<Names, float>> extra)
+    {
+        auto parameters = compressing;
+        parameters.insert(parameters.end(), extra.begin(), extra.end());
+        return parameters;
+    };
+    
+    return
+    {
+        { "defaults", {} },
+        { "compressing", compressing },
+        { "solo-low", with({ { Solo_Low_Band, 1.f } }) },
+        { "solo-mid", with({ { Solo_Mid_Band, 1.f } }) },
+        { "solo-high", with({ { Solo_High_Band, 1.f } }) },
+        { "limiting", with({ { Gain_in, 12.f }, { True_Peak_Limiter, 1.f }, { True_Peak_Ceiling, -1.f } }) },
+    };
+}
+
+void render(const Case& c, const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output)
+{
+    ProcessorHost host(numChannels, sampleRate, blockSize);
+    if( host.getError().isNotEmpty() )
+        juce::ConsoleApplication::fail(host.getError());
+    
+    for( const auto& [name, value] : c.parameters )
+        host.setParameter(name, value);
+    
+    output.makeCopyOf(input);
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    
+    for( int start = 0; start < signalLength; start += blockSize )
+    {
+        auto numSamples = juce::jmin(blockSize, signalLength - start);
+        
+        //hosts can end on a short block, and it's part of what's being checked
+        block.setSize(numChannels, numSamples, false, false, true);
+        for( int ch = 0; ch < numChannels; ++ch )
+            block.copyFrom(ch, 0, output, ch, start, numSamples);
+        
+        host.process(block);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+            output.copyFrom(ch, start, block, ch, 0, numSamples);
+    }
+}
+
+/**
+ the references committed with the source, found by looking up from the working directory and
+ from the tool itself for Tools/Headless/Golden. empty if neither is inside a checkout.
+ */
+juce::File findReferenceDirectory()
+{
+    for( auto start : { juce::File::getCurrentWorkingDirectory(),
+                        juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory() } )
+    {
+        for( auto dir = start; dir.getParentDirectory() != dir; dir = dir.getParentDirectory() )
+        {
+            if( dir.getChildFile("Tools/Headless/Source/Golden.cpp").existsAsFile() )
+                return dir.getChildFile("Tools/Headless/Golden");
+        }
+    }
+    
+    return {};
+}
+
+juce::File getGoldenFile(const juce::File& directory, const Signal& signal, const Case& c)
+{
+    return directory.getChildFile(juce::String(signal.name) + "_" + c.name + ".wav");
+}
+
+bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer)
+{
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+    if( stream == nullptr )
+        return false;
+    
+    //32 bit WAVs are float, so what's stored is exactly what was rendered
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, numChannels, 32, {}, 0));
+    if( writer == nullptr )
+        return false;
+    
+    stream.release();
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+
+bool readWav(const juce::File& file, juce::AudioBuffer<float>& buffer)
+{
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+    if( reader == nullptr || reader->numChannels != numChannels || reader->lengthInSamples != signalLength )
+        return false;
+    
+    buffer.setSize(numChannels, signalLength);
+    return reader->read(&buffer, 0, signalLength, 0, true, true);
+}
+
+/**
+ the worst sample difference between two renders, and where it is, so a failure can be found in them
+ */
+struct Difference
+{
+    float worst {0.f};
+    int channel {0};
+    int sample {0};
+};
+
+Difference compare(const juce::AudioBuffer<float>& actual, const juce::AudioBuffer<float>& expected)
+{
+    Difference difference;
+    
+    for( int ch = 0; ch < numChannels; ++ch )
+    {
+        auto* a = actual.getReadPointer(ch);
+        auto* e = expected.getReadPointer(ch);
+        
+        for( int i = 0; i < signalLength; ++i )
+        {
+            auto error = std::abs(a[i] - e[i]);
+            if( !(error <= difference.worst) )
+            {
+                //NaN lands here too, and always fails
+                difference.worst = std::isnan(error) ? std::numeric_limits<float>::infinity() : error;
+                difference.channel = ch;
+                difference.sample = i;
+            }
+        }
+    }
+    
+    return difference;
+}
+
+bool report(const juce::String& label, const Difference& difference, float tolerance)
+{
+    auto passed = difference.worst <= tolerance;
+    
+    std::cout << label << ": " << (passed ? "ok" : "FAILED") << ", max error " << difference.worst
+              << " at channel " << difference.channel << " sample " << difference.sample << std::endl;
+    
+    return passed;
+}
+
+//==============================================================================
+/**
+ with every band uncompressed the crossover should be an allpass: the sum of the bands has the
+ same magnitude as the input at every frequency. returns the worst deviation in dB from 20 Hz to 20 kHz.
+ */
+float measureCrossoverDeviation(float lowMidHz, float midHighHz)
+{
+    using namespace Params;
+    
+    constexpr int fftOrder = 16;
+    constexpr int fftSize = 1 << fftOrder;
+    
+    ProcessorHost host(numChannels, sampleRate, blockSize);
+    if( host.getError().isNotEmpty() )
+        juce::ConsoleApplication::fail(host.getError());
+    
+    host.setParameter(Low_Mid_Crossover_Freq, lowMidHz);
+    host.setParameter(Mid_High_Crossover_Freq, midHighHz);
+    
+    //the gains ramp in from silence when the processor starts, so let them settle first
+    const auto settleSamples = 16 * blockSize;
+    const auto totalSamples = settleSamples + fftSize + host.getLatencySamples();
+    
+    std::vector<float> response;
+    response.reserve((size_t)totalSamples);
+    
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    for( int start = 0; start < totalSamples; start += blockSize )
+    {
+        block.clear();
+        if( start == settleSamples )
+        {
+            for( int ch = 0; ch < numChannels; ++ch )
+                block.setSample(ch, 0, 1.f);
+        }
+        
+        host.process(block);
+        response.insert(response.end(), block.getReadPointer(0), block.getReadPointer(0) + blockSize);
+    }
+    
+    std::vector<float> fftData((size_t)fftSize * 2, 0.f);
+    std::copy(response.begin() + settleSamples, response.begin() + settleSamples + fftSize, fftData.begin());
+    
+    juce::dsp::FFT fft(fftOrder);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+    
+    auto worst = 0.f;
+    for( int bin = 1; bin < fftSize / 2; ++bin )
+    {
+        auto hz = bin * sampleRate / fftSize;
+        if( hz < 20.0 || hz > 20000.0 )
+            continue;
+        
+        worst = juce::jmax(worst, std::abs(juce::Decibels::gainToDecibels(fftData[(size_t)bin], -200.f)));
+    }
+    
+    return worst;
+}
+}
+
+juce::ConsoleApplication::Command Golden::makeCommand()
+{
+    return
+    {
+        "golden",
+        "golden [--record] [--dir <dir>] [--tolerance <abs>]",
+        "Checks renders against the committed reference renders, or records them.",
+        "Renders a sine sweep, pink noise, impulses and transients at 48 kHz through the processor with default "
+        "settings, with every band compressing, with each band soloed and into the true-peak limiter, and fails "
+        "if any sample differs from the reference render by more than --tolerance (default 1e-5, about -100 dBFS). "
+        "A missing reference fails too. The references are the 32 bit float WAVs in Tools/Headless/Golden, found "
+        "from the working directory or the tool's own location, or in --dir. --record writes them there instead, "
+        "from a build whose sound is the one to keep. "
+        "Every run also fails if rendering the same settings twice differs at all, if the three soloed bands don't "
+        "add up to the unsoloed render within --tolerance, or if the bands of the uncompressed crossover don't sum "
+        "to within 0.01 dB of flat at several crossover settings.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            const auto recording = args.containsOption("--record");
+            
+            auto directory = args.containsOption("--dir") ? args.getFileForOption("--dir") : findReferenceDirectory();
+            if( directory == File() )
+                ConsoleApplication::fail("not run from a checkout, give the references with --dir <dir>");
+            
+            auto tolerance = args.containsOption("--tolerance") ? args.getValueForOption("--tolerance").getFloatValue() : 1.0e-5f;
+            
+            if( recording && !directory.createDirectory() )
+                ConsoleApplication::fail("couldn't create " + directory.getFullPathName());
+            
+            if( !recording && !directory.isDirectory() )
+                ConsoleApplication::fail("no references in " + directory.getFullPathName() + ", record them with golden --record");
+            
+            const auto cases = makeCases();
+            auto findCase = [&cases](const String& name) -> const Case&
+            {
+                auto found = std::find_if(cases.begin(), cases.end(), [&name](const Case& c) { return name == c.name; });
+                jassert(found != cases.end());
+                return *found;
+            };
+            
+            auto numFailed = 0;
+            
+            for( const auto& signal : signals )
+            {
+                AudioBuffer<float> input(numChannels, signalLength);
+                signal.make(input);
+                
+                std::map<String, AudioBuffer<float>> outputs;
+                
+                for( const auto& c : cases )
+                {
+                    auto& output = outputs[c.name];
+                    render(c, input, output);
+                    
+                    auto file = getGoldenFile(directory, signal, c);
+                    auto label = file.getFileNameWithoutExtension();
+                    
+                    if( recording )
+                    {
+                        if( !writeWav(file, output) )
+                            ConsoleApplication::fail("couldn't write " + file.getFullPathName());
+                        
+                        std::cout << label << ": recorded" << std::endl;
+                        continue;
+                    }
+                    
+                    AudioBuffer<float> golden;
+                    if( !readWav(file, golden) )
+                    {
+                        std::cout << label << ": FAILED, missing or unreadable " << file.getFullPathName() << std::endl;
+                        ++numFailed;
+                        continue;
+                    }
+                    
+                    numFailed += report(label, compare(output, golden), tolerance) ? 0 : 1;
+                }
+                
+                //the references below come from the renders themselves, so they need no recording.
+                //a second render of the same settings has to match exactly, or some state isn't reset.
+                AudioBuffer<float> again;
+                render(findCase("compressing"), input, again);
+                numFailed += report(String(signal.name) + " repeated", compare(again, outputs["compressing"]), 0.f) ? 0 : 1;
+                
+                //each band's compressor only hears its own band, so the soloed bands add up to the full mix
+                AudioBuffer<float> soloSum(numChannels, signalLength);
+                soloSum.clear();
+                for( auto name : { "solo-low", "solo-mid", "solo-high" } )
+                {
+                    for( int ch = 0; ch < numChannels; ++ch )
+                        soloSum.addFrom(ch, 0, outputs[name], ch, 0, signalLength);
+                }
+                
+                numFailed += report(String(signal.name) + " solo sum", compare(soloSum, outputs["compressing"]), tolerance) ? 0 : 1;
+            }
+            
+            constexpr float flatnessToleranceDb = 0.01f;
+            const std::array<std::pair<float, float>, 4> crossovers {{ { 400.f, 2000.f }, { 100.f, 1000.f }, { 999.f, 1000.f }, { 250.f, 8000.f } }};
+            
+            for( const auto& [lowMid, midHigh] : crossovers )
+            {
+                auto deviation = measureCrossoverDeviation(lowMid, midHigh);
+                auto passed = deviation <= flatnessToleranceDb;
+                numFailed += passed ? 0 : 1;
+                
+                std::cout << "crossover " << lowMid << "/" << midHigh << " Hz: " << (passed ? "ok" : "FAILED")
+                          << ", " << deviation << " dB from flat" << std::endl;
+            }
+            
+            if( numFailed > 0 )
+                ConsoleApplication::fail(String(numFailed) + " checks failed");
+        }
+    };
+}
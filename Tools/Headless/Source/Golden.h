@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    Golden.h
+    Created: 21 Oct 2026 9:14:02am
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Golden
+{
+/**
+ checks the processor's output for a fixed set of reference signals and settings sample by sample
+ against the reference renders committed in Tools/Headless/Golden, or records them. it also checks
+ that repeated renders match, the soloed bands sum to the full mix and the crossover sums flat.
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
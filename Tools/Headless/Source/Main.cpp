@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 9:48:30pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Render.h"
+#include "Bench.h"
+#include "AnalyzerBench.h"
+#include "RealtimeCheck.h"
+#include "Golden.h"
+#include "Fuzz.h"
+#include "Bank.h"
+#include "DecibelCheck.h"
+#include "UIAllocationCheck.h"
+
+int main(int argc, char* argv[])
+{
+    //the processor's parameter state uses timers, so it needs a message manager even with no UI
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "MultibandCompressor headless tools", true);
+    
+    app.addCommand(Render::makeCommand());
+    app.addCommand(Bench::makeCommand());
+    app.addCommand(AnalyzerBench::makeCommand());
+    app.addCommand(RealtimeCheck::makeCommand());
+    app.addCommand(Golden::makeCommand());
+    app.addCommand(Fuzz::makeCommand());
+    app.addCommand(Bank::makeCommand());
+    app.addCommand(DecibelCheck::makeCommand());
+    app.addCommand(UIAllocationCheck::makeCommand());
+    
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    ProcessorHost.cpp
+    Created: 19 Oct 2026 9:48:30pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "ProcessorHost.h"
+
+ProcessorHost::ProcessorHost(int numChannels,
+                             double sampleRate,
+                             int blockSize,
+                             const juce::MemoryBlock& state)
+{
+    auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+    
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(channelSet);
+    layout.outputBuses.add(channelSet);
+    
+    if( !processor.setBusesLayout(layout) )
+    {
+        error = "only mono and stereo are supported, got " + juce::String(numChannels) + " channels";
+        return;
+    }
+    
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.setNonRealtime(true);
+    
+    if( state.getSize() > 0 )
+        processor.setStateInformation(state.getData(), (int)state.getSize());
+    
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+ProcessorHost::~ProcessorHost()
+{
+    processor.releaseResources();
+}
+
+void ProcessorHost::process(juce::AudioBuffer<float>& buffer)
+{
+    midi.clear();
+    processor.processBlock(buffer, midi);
+}
+
+void ProcessorHost::setParameter(Params::Names name, float value)
+{
+    auto& param = Params::getParam(processor, name);
+    param.setValueNotifyingHost(param.convertTo0to1(value));
+}
+
+juce::Result loadStateFile(const juce::File& file, juce::MemoryBlock& state)
+{
+    if( !file.existsAsFile() )
+        return juce::Result::fail("no such state file: " + file.getFullPathName());
+    
+    if( !file.loadFileAsData(state) )
+        return juce::Result::fail("couldn't read " + file.getFullPathName());
+    
+    //hand written presets are the APVTS tree as XML
+    if( state.getSize() > 0 && static_cast<const char*>(state.getData())[0] == '<' )
+    {
+        auto xml = juce::parseXML(file);
+        auto tree = xml != nullptr ? juce::ValueTree::fromXml(*xml) : juce::ValueTree();
+        
+        if( !tree.isValid() )
+            return juce::Result::fail("couldn't parse " + file.getFullPathName());
+        
+        state.reset();
+        juce::MemoryOutputStream mos(state, false);
+        tree.writeToStream(mos);
+    }
+    
+    return juce::Result::ok();
+}
+
+void writeReport(const juce::var& report, const juce::ArgumentList& args)
+{
+    using namespace juce;
+    
+    auto* object = report.getDynamicObject();
+    jassert(object != nullptr);
+    
+   #if JUCE_DEBUG
+    object->setProperty("build", "debug");
+   #else
+    object->setProperty("build", "release");
+   #endif
+    object->setProperty("time", Time::getCurrentTime().toISO8601(true));
+    
+    auto machine = object->getProperty("machine");
+    if( machine.getDynamicObject() == nullptr )
+        machine = var(new DynamicObject());
+    
+    machine.getDynamicObject()->setProperty("cpu", SystemStats::getCpuModel());
+    machine.getDynamicObject()->setProperty("cores", SystemStats::getNumPhysicalCpus());
+    machine.getDynamicObject()->setProperty("os", SystemStats::getOperatingSystemName());
+    object->setProperty("machine", machine);
+    
+    auto json = JSON::toString(report);
+    
+    if( args.containsOption("--out") )
+    {
+        auto file = args.getFileForOption("--out");
+        if( !file.replaceWithText(json) )
+            ConsoleApplication::fail("couldn't write " + file.getFullPathName());
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+}
+
+juce::int64 getSeed(const juce::ArgumentList& args)
+{
+    auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : juce::Time::currentTimeMillis();
+    std::cout << "seed " << seed << std::endl;
+    return seed;
+}
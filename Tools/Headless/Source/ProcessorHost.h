@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    ProcessorHost.h
+    Created: 19 Oct 2026 9:48:30pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../../Source/DSP/Params.h"
+
+/**
+ owns a MultibandCompressorAudioProcessor set up the way a host would: bus layout, rate,
+ block size and an optional saved state, then prepared. only mono and stereo are supported.
+ */
+struct ProcessorHost
+{
+    ProcessorHost(int numChannels,
+                  double sampleRate,
+                  int blockSize,
+                  const juce::MemoryBlock& state = {});
+    ~ProcessorHost();
+    
+    /**
+     empty if the processor was set up, otherwise what went wrong
+     */
+    const juce::String& getError() const { return error; }
+    
+    void process(juce::AudioBuffer<float>& buffer);
+    
+    int getLatencySamples() const { return processor.getLatencySamples(); }
+    
+    /**
+     sets a parameter in its own units (dB, Hz, ms, choice index, 0/1) as if a host automated it
+     */
+    void setParameter(Params::Names name, float value);
+    
+    MultibandCompressorAudioProcessor processor;
+    
+private:
+    juce::MidiBuffer midi;
+    juce::String error;
+};
+
+/**
+ reads a preset for --state. takes a blob getStateInformation() wrote, in either the binary
+ format or the older APVTS tree, or the tree as XML so presets can be written by hand.
+ */
+juce::Result loadStateFile(const juce::File& file, juce::MemoryBlock& state);
+
+/**
+ adds what every benchmark report has, the build, the time and the machine, to 'report' and
+ writes it as JSON to --out, or to stdout if that isn't given. 'report' has to be a DynamicObject,
+ and any "machine" object it already has is added to rather than replaced.
+ */
+void writeReport(const juce::var& report, const juce::ArgumentList& args);
+
+/**
+ the --seed option, or the time if it isn't given. it's printed so a failing run can be repeated.
+ */
+juce::int64 getSeed(const juce::ArgumentList& args);
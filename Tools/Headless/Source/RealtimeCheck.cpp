@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.cpp
+    Created: 20 Oct 2026 2:37:08pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "RealtimeCheck.h"
+#include "RealtimeGuard.h"
+#include "ProcessorHost.h"
+
+namespace
+{
+/**
+ moves every parameter to a random value, the way a host replaying automation might.
+ runs on the calling thread, which is never armed.
+ */
+void randomiseParameters(MultibandCompressorAudioProcessor& processor, juce::Random& random)
+{
+    for( auto* param : processor.getParameters() )
+        param->setValueNotifyingHost(random.nextFloat());
+}
+
+/**
+ returns the number of blocks processed. a violation never returns, see RealtimeGuard.
+ */
+int run(int numChannels, double sampleRate, int maxBlockSize, double seconds, juce::Random& random)
+{
+    ProcessorHost host(numChannels, sampleRate, maxBlockSize);
+    if( host.getError().isNotEmpty() )
+        juce::ConsoleApplication::fail(host.getError());
+    
+    juce::AudioBuffer<float> buffer(numChannels, maxBlockSize);
+    
+    const auto totalSamples = juce::int64(seconds * sampleRate);
+    juce::int64 samplesDone = 0;
+    int numBlocks = 0;
+    
+    const auto context = "processing " + juce::String(numChannels) + " channels at " + juce::String(sampleRate) + " Hz";
+    
+    while( samplesDone < totalSamples )
+    {
+        //hosts are allowed to send anything up to the prepared size, including a single sample
+        auto blockSize = random.nextInt(8) == 0 ? 1 + random.nextInt(maxBlockSize) : maxBlockSize;
+        buffer.setSize(numChannels, blockSize, false, false, true);
+        
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            auto* samples = buffer.getWritePointer(ch);
+            for( int i = 0; i < blockSize; ++i )
+                samples[i] = random.nextFloat() * 2.f - 1.f;
+        }
+        
+        if( numBlocks % 16 == 0 )
+            randomiseParameters(host.processor, random);
+        
+        {
+            RealtimeGuard::ScopedArm audioThread;
+            RealtimeGuard::setContext(context.toRawUTF8());
+            
+            host.process(buffer);
+        }
+        
+        samplesDone += blockSize;
+        ++numBlocks;
+    }
+    
+    return numBlocks;
+}
+}
+
+juce::ConsoleApplication::Command RealtimeCheck::makeCommand()
+{
+    return
+    {
+        "rtcheck",
+        "rtcheck [--seconds <s>] [--seed <n>]",
+        "Fails if processBlock allocates, locks, sleeps or does file I/O.",
+        "Processes noise at several rates and channel counts with random block sizes up to the prepared size, "
+        "randomising every parameter every 16 blocks. The calls that can block, such as malloc/free, mutex "
+        "locks, condition waits, sleeps and file reads and writes, are intercepted while processBlock runs. "
+        "The first one prints a stack trace and the tool exits with status 1. --seconds sets how much audio "
+        "each configuration processes (default 5), --seed makes a failing run repeatable. Linux only.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            if( !RealtimeGuard::isSupported() )
+                ConsoleApplication::fail("rtcheck isn't supported on this platform");
+            
+            auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 5.0;
+            seconds = jlimit(0.01, 600.0, seconds);
+            
+            Random random(getSeed(args));
+            
+            for( auto sampleRate : { 44100.0, 96000.0 } )
+            {
+                for( auto numChannels : { 1, 2 } )
+                {
+                    for( auto maxBlockSize : { 64, 512, 4096 } )
+                    {
+                        auto numBlocks = run(numChannels, sampleRate, maxBlockSize, seconds, random);
+                        
+                        std::cout << numChannels << " ch, " << sampleRate << " Hz, up to "
+                                  << maxBlockSize << " samples: " << numBlocks << " blocks ok" << std::endl;
+                    }
+                }
+            }
+            
+            std::cout << "no real-time violations" << std::endl;
+        }
+    };
+}
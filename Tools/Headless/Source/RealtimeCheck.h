@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.h
+    Created: 20 Oct 2026 2:37:08pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace RealtimeCheck
+{
+/**
+ runs processBlock with RealtimeGuard armed while parameters are automated and block sizes
+ change, and fails on the first call that isn't real-time safe
+ */
+juce::ConsoleApplication::Command makeCommand();
+}
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 20 Oct 2026 2:37:08pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+//the fortified inline wrappers for open() and read() would clash with the replacements below
+#ifdef _FORTIFY_SOURCE
+ #undef _FORTIFY_SOURCE
+#endif
+
+#include "RealtimeGuard.h"
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+//glibc's own allocator entry points, so the replacements don't need dlsym
+extern "C"
+{
+void* __libc_malloc(size_t) noexcept;
+void* __libc_calloc(size_t, size_t) noexcept;
+void* __libc_realloc(void*, size_t) noexcept;
+void* __libc_memalign(size_t, size_t) noexcept;
+void __libc_free(void*) noexcept;
+}
+
+namespace
+{
+thread_local int armedDepth = 0;
+thread_local const char* currentContext = nullptr;
+thread_local long long numAllocations = 0;
+
+/**
+ looks up the C library's version of a function the first time it's needed
+ */
+void* real(std::atomic<void*>& cache, const char* name) noexcept
+{
+    auto function = cache.load(std::memory_order_acquire);
+    if( function == nullptr )
+    {
+        function = dlsym(RTLD_NEXT, name);
+        cache.store(function, std::memory_order_release);
+    }
+    
+    return function;
+}
+
+#define REAL_FUNCTION(name) \
+    static std::atomic<void*> cache {nullptr}; \
+    auto real_##name = reinterpret_cast<decltype(&::name)>(real(cache, #name))
+
+ssize_t writeToStderr(const char* text) noexcept
+{
+    REAL_FUNCTION(write);
+    return real_write(STDERR_FILENO, text, std::strlen(text));
+}
+
+/**
+ called from inside a replaced function on an armed thread. disarms first, so reporting can
+ allocate and write freely.
+ */
+[[noreturn]] void violation(const char* function) noexcept
+{
+    armedDepth = 0;
+    
+    writeToStderr("real-time violation: ");
+    writeToStderr(function);
+    writeToStderr("() called on the audio thread");
+    
+    if( currentContext != nullptr )
+    {
+        writeToStderr(" while ");
+        writeToStderr(currentContext);
+    }
+    
+    writeToStderr("\n");
+    
+    void* frames[64];
+    auto numFrames = backtrace(frames, 64);
+    backtrace_symbols_fd(frames, numFrames, STDERR_FILENO);
+    
+    std::_Exit(1);
+}
+
+inline void check(const char* function) noexcept
+{
+    if( armedDepth > 0 )
+        violation(function);
+}
+
+inline void checkAllocation(const char* function) noexcept
+{
+    ++numAllocations;
+    check(function);
+}
+
+//backtrace() loads its unwinder on first use, which allocates. do that before anything is armed.
+const bool backtraceReady = []
+{
+    void* frame;
+    return backtrace(&frame, 1) >= 0;
+}();
+}
+
+bool RealtimeGuard::isSupported() noexcept { return backtraceReady; }
+
+RealtimeGuard::ScopedArm::ScopedArm() noexcept { ++armedDepth; }
+RealtimeGuard::ScopedArm::~ScopedArm() noexcept { --armedDepth; }
+
+void RealtimeGuard::setContext(const char* context) noexcept { currentContext = context; }
+
+RealtimeGuard::ScopedAllocationCount::ScopedAllocationCount() noexcept : start(numAllocations) {}
+long long RealtimeGuard::ScopedAllocationCount::getNumAllocations() const noexcept { return numAllocations - start; }
+
+//==============================================================================
+extern "C"
+{
+void* malloc(size_t size) noexcept
+{
+    checkAllocation("malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept
+{
+    checkAllocation("calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    checkAllocation("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept
+{
+    //free(nullptr) is a no-op and is safe
+    if( ptr != nullptr )
+        check("free");
+    
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept
+{
+    checkAllocation("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    checkAllocation("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept
+{
+    checkAllocation("posix_memalign");
+    
+    if( alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0 )
+        return EINVAL;
+    
+    auto* memory = __libc_memalign(alignment, size);
+    if( memory == nullptr )
+        return ENOMEM;
+    
+    *ptr = memory;
+    return 0;
+}
+
+//trylock never blocks, so it's left alone
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+{
+    check("pthread_mutex_lock");
+    REAL_FUNCTION(pthread_mutex_lock);
+    return real_pthread_mutex_lock(mutex);
+}
+
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex)
+{
+    check("pthread_cond_wait");
+    REAL_FUNCTION(pthread_cond_wait);
+    return real_pthread_cond_wait(cond, mutex);
+}
+
+int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* time)
+{
+    check("pthread_cond_timedwait");
+    REAL_FUNCTION(pthread_cond_timedwait);
+    return real_pthread_cond_timedwait(cond, mutex, time);
+}
+
+int sem_wait(sem_t* semaphore)
+{
+    check("sem_wait");
+    REAL_FUNCTION(sem_wait);
+    return real_sem_wait(semaphore);
+}
+
+int nanosleep(const struct timespec* duration, struct timespec* remaining)
+{
+    check("nanosleep");
+    REAL_FUNCTION(nanosleep);
+    return real_nanosleep(duration, remaining);
+}
+
+int usleep(useconds_t microseconds)
+{
+    check("usleep");
+    REAL_FUNCTION(usleep);
+    return real_usleep(microseconds);
+}
+
+int poll(struct pollfd* fds, nfds_t numFds, int timeout)
+{
+    check("poll");
+    REAL_FUNCTION(poll);
+    return real_poll(fds, numFds, timeout);
+}
+
+int open(const char* path, int flags, ...)
+{
+    check("open");
+    REAL_FUNCTION(open);
+    
+    mode_t mode = 0;
+    if( (flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE )
+    {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, mode_t);
+        va_end(args);
+    }
+    
+    return real_open(path, flags, mode);
+}
+
+int openat(int directory, const char* path, int flags, ...)
+{
+    check("openat");
+    REAL_FUNCTION(openat);
+    
+    mode_t mode = 0;
+    if( (flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE )
+    {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, mode_t);
+        va_end(args);
+    }
+    
+    return real_openat(directory, path, flags, mode);
+}
+
+ssize_t read(int fd, void* buffer, size_t numBytes)
+{
+    check("read");
+    REAL_FUNCTION(read);
+    return real_read(fd, buffer, numBytes);
+}
+
+ssize_t write(int fd, const void* buffer, size_t numBytes)
+{
+    check("write");
+    REAL_FUNCTION(write);
+    return real_write(fd, buffer, numBytes);
+}
+}
+
+#else
+
+bool RealtimeGuard::isSupported() noexcept { return false; }
+
+RealtimeGuard::ScopedArm::ScopedArm() noexcept {}
+RealtimeGuard::ScopedArm::~ScopedArm() noexcept {}
+
+void RealtimeGuard::setContext(const char*) noexcept {}
+
+RealtimeGuard::ScopedAllocationCount::ScopedAllocationCount() noexcept : start(0) {}
+long long RealtimeGuard::ScopedAllocationCount::getNumAllocations() const noexcept { return 0; }
+
+#endif
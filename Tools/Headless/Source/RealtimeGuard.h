@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 20 Oct 2026 2:37:08pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+ catches calls that aren't real-time safe on a thread that's marked as the audio thread.
+ 
+ on Linux the tool replaces malloc and friends, pthread mutex and condition variable waits,
+ semaphores, sleeps, file opens, reads, writes and polls with versions that check whether the
+ calling thread is armed. the first violation prints what was called, the context and a stack
+ trace to stderr and exits with status 1. unarmed threads pay one thread_local check per call.
+ 
+ the allocators also keep a per thread count, see ScopedAllocationCount. everything that reaches
+ the heap goes through them: operator new as well as juce::HeapBlock, AudioBuffer, Path and Image.
+ 
+ this file deliberately doesn't include JuceHeader.h, the replacements have to match the C
+ library's own declarations.
+ */
+namespace RealtimeGuard
+{
+/**
+ false where the calls can't be intercepted, in which case arming does nothing
+ */
+bool isSupported() noexcept;
+
+/**
+ marks the calling thread as the audio thread for the lifetime of the object
+ */
+struct ScopedArm
+{
+    ScopedArm() noexcept;
+    ~ScopedArm() noexcept;
+    
+    ScopedArm(const ScopedArm&) = delete;
+    ScopedArm& operator=(const ScopedArm&) = delete;
+};
+
+/**
+ describes what the armed thread is doing, printed with a violation. 'context' must outlive
+ the armed section, it isn't copied.
+ */
+void setContext(const char* context) noexcept;
+
+/**
+ counts the heap allocations the calling thread makes while it exists. unlike ScopedArm nothing
+ fails, it's for code that should settle into not allocating rather than code that never may.
+ */
+struct ScopedAllocationCount
+{
+    ScopedAllocationCount() noexcept;
+    
+    long long getNumAllocations() const noexcept;
+    
+    ScopedAllocationCount(const ScopedAllocationCount&) = delete;
+    ScopedAllocationCount& operator=(const ScopedAllocationCount&) = delete;
+    
+private:
+    long long start;
+};
+}
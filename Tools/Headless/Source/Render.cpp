@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    Render.cpp
+    Created: 19 Oct 2026 9:48:30pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "Render.h"
+#include "ProcessorHost.h"
+
+juce::String Render::renderFile(const juce::File& input, const Settings& settings)
+{
+    using namespace juce;
+    
+    AudioFormatManager formats;
+    formats.registerBasicFormats();
+    
+    auto* format = formats.findFormatForFileExtension(input.getFileExtension());
+    if( format == nullptr )
+        return "unsupported file type";
+    
+    std::unique_ptr<MemoryMappedAudioFormatReader> reader(format->createMemoryMappedReader(input));
+    if( reader == nullptr || !reader->mapEntireFile() )
+        return "couldn't memory-map the file";
+    
+    const auto numChannels = (int)reader->numChannels;
+    const auto sampleRate = reader->sampleRate;
+    const auto length = reader->lengthInSamples;
+    const auto blockSize = settings.blockSize;
+    
+    ProcessorHost host(numChannels, sampleRate, blockSize, settings.state);
+    if( host.getError().isNotEmpty() )
+        return host.getError();
+    
+    auto outputFile = settings.outputDirectory.getChildFile(input.getFileName());
+    if( outputFile == input )
+        return "the output would overwrite the input";
+    
+    outputFile.deleteFile();
+    auto stream = outputFile.createOutputStream();
+    if( stream == nullptr )
+        return "couldn't create " + outputFile.getFullPathName();
+    
+    //JUCE's writers take 32 bits to mean float, so a float input is written as 32 bit float and an
+    //integer input stays integer, at 24 bits if it was 32. 24 bits matches the precision of the
+    //float samples the processor produces at full scale.
+    auto bitsPerSample = (int)reader->bitsPerSample;
+    if( reader->usesFloatingPointData )
+        bitsPerSample = 32;
+    else if( bitsPerSample > 24 )
+        bitsPerSample = 24;
+    
+    std::unique_ptr<AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                      sampleRate,
+                                                                      (unsigned int)numChannels,
+                                                                      bitsPerSample,
+                                                                      reader->metadataValues,
+                                                                      0));
+    if( writer == nullptr )
+        return "couldn't create a writer for " + outputFile.getFullPathName();
+    
+    //the writer owns the stream now
+    stream.release();
+    
+    AudioBuffer<float> buffer(numChannels, blockSize);
+    
+    //the first 'latency' samples out are the processor's delay. they're dropped, and the end is
+    //run out with silence so the output ends up exactly as long as the input.
+    auto samplesToSkip = (int64)host.getLatencySamples();
+    int64 readPosition = 0;
+    int64 numWritten = 0;
+    
+    while( numWritten < length )
+    {
+        buffer.clear();
+        
+        auto numToRead = (int)jlimit<int64>(0, blockSize, length - readPosition);
+        if( numToRead > 0 )
+            reader->read(&buffer, 0, numToRead, readPosition, true, true);
+        
+        readPosition += blockSize;
+        host.process(buffer);
+        
+        auto start = (int)jmin<int64>(samplesToSkip, blockSize);
+        samplesToSkip -= start;
+        
+        auto numToWrite = (int)jmin<int64>(blockSize - start, length - numWritten);
+        if( numToWrite > 0 && !writer->writeFromAudioSampleBuffer(buffer, start, numToWrite) )
+            return "write failed for " + outputFile.getFullPathName();
+        
+        numWritten += jmax(0, numToWrite);
+    }
+    
+    return {};
+}
+
+juce::ConsoleApplication::Command Render::makeCommand()
+{
+    return
+    {
+        "render",
+        "render [--state <preset>] [--out <dir>] [--jobs <n>] [--block <n>] [--trace <file.json>] <files...>",
+        "Processes WAV/AIFF files offline.",
+        "Each input is memory-mapped, streamed through the processor and written with the same name and format "
+        "into --out (default: ./rendered). Float files stay 32 bit float and integer files stay integer, except "
+        "32 bit integer, which is written as 24 bit since JUCE only writes 32 bits as float. Files are rendered in parallel, one per core unless --jobs says otherwise. "
+        "--state takes a saved plugin state or the parameter tree as XML. In a build with MULTIBAND_TRACING=1, "
+        "--trace writes a timeline of every render thread's processBlock stages in the Chrome trace format.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            Settings settings;
+            settings.outputDirectory = args.containsOption("--out") ? args.getFileForOption("--out")
+                                                                    : File::getCurrentWorkingDirectory().getChildFile("rendered");
+            
+            if( args.containsOption("--block") )
+                settings.blockSize = jlimit(16, 8192, args.getValueForOption("--block").getIntValue());
+            
+            if( args.containsOption("--state") )
+            {
+                auto result = loadStateFile(args.getFileForOption("--state"), settings.state);
+                if( result.failed() )
+                    ConsoleApplication::fail(result.getErrorMessage());
+            }
+            
+           #if MULTIBAND_TRACING
+            SharedResourcePointer<TraceRecorder> traceRecorder;
+            if( args.containsOption("--trace") && !traceRecorder->start(args.getFileForOption("--trace")) )
+                ConsoleApplication::fail("couldn't write " + args.getFileForOption("--trace").getFullPathName());
+           #else
+            if( args.containsOption("--trace") )
+                ConsoleApplication::fail("--trace needs a build with MULTIBAND_TRACING=1");
+           #endif
+            
+            auto numJobs = args.containsOption("--jobs") ? args.getValueForOption("--jobs").getIntValue()
+                                                         : SystemStats::getNumCpus();
+            numJobs = jmax(1, numJobs);
+            
+            //every plain argument after the command name is an input file
+            Array<File> inputs;
+            for( int i = 1; i < args.size(); ++i )
+            {
+                const auto& arg = args[i];
+                if( arg.isOption() )
+                {
+                    //skip the option's value too
+                    if( !arg.text.contains("=") )
+                        ++i;
+                    continue;
+                }
+                
+                inputs.add(arg.resolveAsExistingFile());
+            }
+            
+            if( inputs.isEmpty() )
+                ConsoleApplication::fail("no input files");
+            
+            if( !settings.outputDirectory.createDirectory() )
+                ConsoleApplication::fail("couldn't create " + settings.outputDirectory.getFullPathName());
+            
+            std::vector<String> errors((size_t)inputs.size());
+            
+            {
+                ThreadPool pool(jmin(numJobs, inputs.size()));
+                for( int i = 0; i < inputs.size(); ++i )
+                {
+                    pool.addJob([&errors, &settings, input = inputs[i], i]()
+                    {
+                        errors[(size_t)i] = renderFile(input, settings);
+                    });
+                }
+                
+                while( pool.getNumJobs() > 0 )
+                    Thread::sleep(20);
+            }
+            
+           #if MULTIBAND_TRACING
+            traceRecorder->stop();
+           #endif
+            
+            auto numFailed = 0;
+            for( int i = 0; i < inputs.size(); ++i )
+            {
+                const auto& error = errors[(size_t)i];
+                std::cout << inputs[i].getFileName() << ": " << (error.isEmpty() ? String("ok") : error) << std::endl;
+                numFailed += error.isEmpty() ? 0 : 1;
+            }
+            
+            if( numFailed > 0 )
+                ConsoleApplication::fail(String(numFailed) + " of " + String(inputs.size()) + " files failed");
+        }
+    };
+}
@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    Render.h
+    Created: 19 Oct 2026 9:48:30pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace Render
+{
+struct Settings
+{
+    juce::MemoryBlock state;
+    juce::File outputDirectory;
+    int blockSize {512};
+};
+
+/**
+ streams 'input' through the processor into a file of the same name and format in the output
+ directory. the input is memory-mapped, and the output is shifted back by the processor's latency
+ so it lines up with the input sample for sample. returns an error message, or an empty string.
+ */
+juce::String renderFile(const juce::File& input, const Settings& settings);
+
+juce::ConsoleApplication::Command makeCommand();
+}
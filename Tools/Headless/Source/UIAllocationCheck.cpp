@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    UIAllocationCheck.cpp
+    Created: 21 Oct 2026 5:22:50pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#include "UIAllocationCheck.h"
+#include "RealtimeGuard.h"
+#include "ProcessorHost.h"
+#include "../../../Source/PluginEditor.h"
+#include "../../../Source/GUI/AnalyzerSettings.h"
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int framesPerSecond = 60;
+
+//long enough for a resolution change to be built on the analyzer's background thread and swapped in
+constexpr int warmUpFrames = 2 * framesPerSecond;
+
+struct Result
+{
+    int numFramesAllocating {0};
+    long long numAllocations {0};
+    long long worstFrame {0};
+    long long numPaintAllocations {0};
+};
+
+Result run(int resolution, int numFrames)
+{
+    using namespace juce;
+    
+    ProcessorHost host(2, sampleRate, blockSize);
+    if( host.getError().isNotEmpty() )
+        ConsoleApplication::fail(host.getError());
+    
+    auto& processor = host.processor;
+    
+    //low thresholds so the gain reduction overlay and history move every frame
+    for( auto name : { Params::Threshold_Low_Band, Params::Threshold_Mid_Band, Params::Threshold_High_Band } )
+        host.setParameter(name, -36.f);
+    
+    //averaging and smoothing so the smoother's storage is part of the frame too
+    AnalyzerSettings::set(processor.editorState, AnalyzerSettings::Resolution, resolution);
+    AnalyzerSettings::set(processor.editorState, AnalyzerSettings::Response, 1);
+    AnalyzerSettings::set(processor.editorState, AnalyzerSettings::Smoothing, 2);
+    
+    //nothing runs the message loop, so the editor's own timer never fires and its frames are driven here
+    std::unique_ptr<AudioProcessorEditor> editorComponent(processor.createEditor());
+    auto* editor = dynamic_cast<MultibandCompressorAudioProcessorEditor*>(editorComponent.get());
+    jassert(editor != nullptr);
+    
+    Image image(Image::RGB, editor->getWidth(), editor->getHeight(), true, SoftwareImageType());
+    
+    AudioBuffer<float> audio(2, blockSize);
+    Random random(0x5eed);
+    const auto samplesPerFrame = roundToInt(sampleRate / framesPerSecond);
+    
+    Result result;
+    
+    for( int frame = 0; frame < warmUpFrames + numFrames; ++frame )
+    {
+        //noise swelling up and down by 20 dB every couple of seconds, in host sized blocks
+        auto level = Decibels::decibelsToGain(-26.f + 10.f * std::sin(float(frame) * 0.05f));
+        
+        for( int done = 0; done < samplesPerFrame; )
+        {
+            auto numSamples = jmin(blockSize, samplesPerFrame - done);
+            AudioBuffer<float> block(audio.getArrayOfWritePointers(), 2, numSamples);
+            
+            for( int ch = 0; ch < 2; ++ch )
+            {
+                for( int i = 0; i < numSamples; ++i )
+                    block.setSample(ch, i, (random.nextFloat() * 2.f - 1.f) * level);
+            }
+            
+            host.process(block);
+            done += numSamples;
+        }
+        
+        long long numAllocations = 0;
+        {
+            RealtimeGuard::ScopedAllocationCount allocations;
+            editor->timerCallback();
+            numAllocations = allocations.getNumAllocations();
+        }
+        
+        long long numPaintAllocations = 0;
+        {
+            Graphics g(image);
+            RealtimeGuard::ScopedAllocationCount allocations;
+            editor->paintEntireComponent(g, false);
+            numPaintAllocations = allocations.getNumAllocations();
+        }
+        
+        if( frame < warmUpFrames )
+        {
+            Thread::sleep(1);
+            continue;
+        }
+        
+        if( numAllocations > 0 )
+        {
+            ++result.numFramesAllocating;
+            result.numAllocations += numAllocations;
+            result.worstFrame = jmax(result.worstFrame, numAllocations);
+        }
+        
+        result.numPaintAllocations += numPaintAllocations;
+    }
+    
+    return result;
+}
+}
+
+juce::ConsoleApplication::Command UIAllocationCheck::makeCommand()
+{
+    return
+    {
+        "ui-alloc",
+        "ui-alloc [--frames <n>]",
+        "Fails if the editor's frames still allocate once they've warmed up.",
+        "Opens the editor on a processor playing noise and drives its frame clock by hand at 60 frames a "
+        "second, at every analyzer resolution. After " + juce::String(warmUpFrames) + " warm up frames, "
+        "every malloc, calloc, realloc and aligned allocation the frame update makes on the message thread is "
+        "counted, which includes operator new, juce::HeapBlock, AudioBuffer, Path and Image. --frames sets how "
+        "many frames are checked per resolution (default 600). Painting is counted and reported too, but "
+        "doesn't fail the check: JUCE's software renderer builds its edge tables on the heap. Linux only.",
+        [](const juce::ArgumentList& args)
+        {
+            using namespace juce;
+            
+            if( !RealtimeGuard::isSupported() )
+                ConsoleApplication::fail("ui-alloc isn't supported on this platform");
+            
+            auto numFrames = args.containsOption("--frames") ? args.getValueForOption("--frames").getIntValue() : 600;
+            numFrames = jlimit(1, 100000, numFrames);
+            
+            auto failed = false;
+            
+            for( int resolution = 0; resolution < (int)AnalyzerSettings::resolutionNames.size(); ++resolution )
+            {
+                auto result = run(resolution, numFrames);
+                
+                std::cout << AnalyzerSettings::resolutionNames[(size_t)resolution] << ": " << numFrames << " frames, "
+                          << result.numFramesAllocating << " allocating";
+                
+                if( result.numFramesAllocating > 0 )
+                    std::cout << " (" << result.numAllocations << " allocations, at most " << result.worstFrame << " in a frame)";
+                
+                std::cout << ", paint " << String(double(result.numPaintAllocations) / numFrames, 1)
+                          << " allocations a frame" << std::endl;
+                
+                failed = failed || result.numFramesAllocating > 0;
+            }
+            
+            if( failed )
+                ConsoleApplication::fail("the editor's frames allocate in the steady state");
+            
+            std::cout << "no allocations in the steady state" << std::endl;
+        }
+    };
+}
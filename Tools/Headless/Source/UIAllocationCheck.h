@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    UIAllocationCheck.h
+    Created: 21 Oct 2026 5:22:50pm
+    Author:  Sol Harter
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace UIAllocationCheck
+{
+/**
+ drives the editor's frame clock by hand while audio plays, counting every heap allocation the
+ frames make through RealtimeGuard, and fails if a frame still allocates once it's warmed up
+ */
+juce::ConsoleApplication::Command makeCommand();
+}